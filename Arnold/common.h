@@ -10,6 +10,7 @@
 #endif
 
 #include "dataUniqueness.h"
+#include "stats.h"
 #include "utility.h"
 
 /**
@@ -60,6 +61,10 @@ struct userData {
   char* gDataString;
   std::string gCurvesMode;
   std::string gPointsMode;
+  float gPointsLod;  // ratio of particles kept, 1 means no decimation
+  std::string gPointsLodCamera;
+  float gPointsLodDistance;  // distance to the camera at which gPointsLod applies
+  AtPoint gPointsLodCameraPos;  // in the procedural's space
   AtArray* gProcShaders;
   AtArray* gProcDispMap;
   std::vector<objectInfo> gIObjects;
@@ -82,6 +87,8 @@ struct userData {
   float disp_height;
   bool disp_autobump;
   float disp_padding;
+
+  expansionStats stats;
 };
 
 // General Node Data
@@ -1,6 +1,7 @@
 #include "stdafx.h"
 
 #include "curves.h"
+#include "motionKeys.h"
 
 AtNode *createCurvesNode(nodeData &nodata, userData *ud,
                          std::vector<float> &samples, int i)
@@ -23,14 +24,15 @@ AtNode *createCurvesNode(nodeData &nodata, userData *ud,
   AtULong posOffset = 0;
   size_t totalNumPoints = 0;
   size_t totalNumPositions = 0;
+  motionKeyReader<Alembic::AbcGeom::ICurvesSchema> keys(
+      typedObject.getSchema(), samples, minNumSamples);
+  keys.addToStats(ud->stats);
   for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
-    SampleInfo sampleInfo = getSampleInfo(
-        samples[sampleIndex], typedObject.getSchema().getTimeSampling(),
-        typedObject.getSchema().getNumSamples());
+    SampleInfo &sampleInfo = keys.info(sampleIndex);
 
     // get the floor sample
-    Alembic::AbcGeom::ICurvesSchema::Sample sample;
-    typedObject.getSchema().get(sample, sampleInfo.floorIndex);
+    Alembic::AbcGeom::ICurvesSchema::Sample &sample =
+        keys.floorSample(sampleIndex);
 
     // access the num points
     Alembic::Abc::Int32ArraySamplePtr abcNumPoints =
@@ -127,10 +129,9 @@ AtNode *createCurvesNode(nodeData &nodata, userData *ud,
 
     // if we have to interpolate
     bool done = false;
-    if (sampleInfo.alpha > sampleTolerance) {
-      Alembic::AbcGeom::ICurvesSchema::Sample sample2;
-      typedObject.getSchema().get(sample2, sampleInfo.ceilIndex);
-      Alembic::Abc::P3fArraySamplePtr abcPos2 = sample2.getPositions();
+    if (keys.needsInterpolation(sampleIndex)) {
+      Alembic::Abc::P3fArraySamplePtr abcPos2 =
+          keys.ceilSample(sampleIndex).getPositions();
       float alpha = (float)sampleInfo.alpha;
       float ialpha = 1.0f - alpha;
       size_t offset = 0;
@@ -2,134 +2,261 @@
 
 #include "dataUniqueness.h"
 
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
 // --------------------------------------------------------------------------------------------------
-typedef struct __uv_mkey {
-  int vertexId;
-  float uv_x;
-  float uv_y;
-} uv_mkey;
+// Hashed face-varying deduplication.
+//
+// A face-varying attribute is welded on the pair <vertexId, value>. Instead of
+// an ordered tree, every face-vertex is hashed on its vertex id and the raw
+// bits of its float components into an open-addressing table (linear probing)
+// that only stores the position of the first occurrence of each key. Keys are
+// compared against the input spans directly, so nothing but positions is
+// copied.
+//
+// Face-vertices that don't share a vertex id can never be equal, so large
+// meshes are partitioned on the vertex id and each partition is resolved by
+// its own thread and its own table. The final numbering is then done in a
+// single ordered pass, which gives exactly the same indices as the former
+// std::map implementation (new indices in order of first occurrence).
 
-class uv_mkey_less : public std::binary_function<uv_mkey, uv_mkey, bool> {
- public:
-  bool operator()(const uv_mkey &p1, const uv_mkey &p2) const
+namespace {
+
+// -0.0f and 0.0f compared equal in the former std::map, keep it that way
+inline AtUInt32 floatBits(float f)
+{
+  if (f == 0.0f) {
+    f = 0.0f;
+  }
+  AtUInt32 bits;
+  memcpy(&bits, &f, sizeof(bits));
+  return bits;
+}
+
+inline AtUInt32 hashMix(AtUInt32 h, AtUInt32 k)
+{
+  k *= 0xcc9e2d51;
+  k = (k << 15) | (k >> 17);
+  k *= 0x1b873593;
+  h ^= k;
+  h = (h << 13) | (h >> 19);
+  return h * 5 + 0xe6546b64;
+}
+
+inline AtUInt32 hashFinalize(AtUInt32 h)
+{
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+  return h;
+}
+
+const size_t gEmptySlot = (size_t)-1;
+
+// contiguous input of the kernel, N is the number of float components
+template <int N>
+struct faceVaryingSpan {
+  const AtUInt32 *vertexIds;  // one per face-vertex
+  const AtUInt32 *valueIds;   // one per face-vertex, index into values
+  const float *values;        // N floats per value
+  size_t count;
+
+  inline AtUInt32 hash(size_t i) const
   {
-    if (p1.vertexId < p2.vertexId) {
-      return true;
+    AtUInt32 h = hashMix(0, vertexIds[i]);
+    const float *v = values + (size_t)valueIds[i] * N;
+    for (int c = 0; c < N; ++c) {
+      h = hashMix(h, floatBits(v[c]));
     }
-    else if (p1.vertexId > p2.vertexId) {
+    return hashFinalize(h);
+  }
+
+  inline bool equal(size_t i, size_t j) const
+  {
+    if (vertexIds[i] != vertexIds[j]) {
       return false;
     }
+    const float *vi = values + (size_t)valueIds[i] * N;
+    const float *vj = values + (size_t)valueIds[j] * N;
+    for (int c = 0; c < N; ++c) {
+      if (floatBits(vi[c]) != floatBits(vj[c])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+template <int N>
+class faceVaryingTable {
+ public:
+  faceVaryingTable(const faceVaryingSpan<N> &span, size_t expected)
+      : mSpan(span), mSize(0)
+  {
+    size_t capacity = 16;
+    while (capacity < expected * 2) {
+      capacity <<= 1;
+    }
+    mSlots.assign(capacity, gEmptySlot);
+  }
 
-    else if (p1.uv_x < p2.uv_x) {
-      return true;
+  // returns the position of the first face-vertex equal to face-vertex i
+  size_t findOrInsert(size_t i)
+  {
+    if ((mSize + 1) * 2 > mSlots.size()) {
+      grow();
     }
-    else if (p1.uv_x > p2.uv_x) {
-      return false;
+    const size_t mask = mSlots.size() - 1;
+    for (size_t s = mSpan.hash(i) & mask;; s = (s + 1) & mask) {
+      if (mSlots[s] == gEmptySlot) {
+        mSlots[s] = i;
+        ++mSize;
+        return i;
+      }
+      if (mSpan.equal(mSlots[s], i)) {
+        return mSlots[s];
+      }
     }
+  }
 
-    return p1.uv_y < p2.uv_y;
+ private:
+  void grow()
+  {
+    std::vector<size_t> old;
+    old.swap(mSlots);
+    mSlots.assign(old.size() * 2, gEmptySlot);
+    const size_t mask = mSlots.size() - 1;
+    for (size_t o = 0; o < old.size(); ++o) {
+      if (old[o] == gEmptySlot) {
+        continue;
+      }
+      size_t s = mSpan.hash(old[o]) & mask;
+      while (mSlots[s] != gEmptySlot) {
+        s = (s + 1) & mask;
+      }
+      mSlots[s] = old[o];
+    }
   }
-};
 
-typedef std::map<uv_mkey, int, uv_mkey_less>
-    uv_map_mkey_to_int;  // a map from UVs to their respective indices!
+  const faceVaryingSpan<N> &mSpan;
+  std::vector<size_t> mSlots;
+  size_t mSize;
+};
 
-AtArray *removeUvsDuplicate(Alembic::AbcGeom::IV2fGeomParam &uvParam,
-                            SampleInfo &sampleInfo, AtArray *uvsIdx,
-                            AtArray *faceIndices)
+template <int N>
+void findFirstOccurrences(const faceVaryingSpan<N> &span, size_t partition,
+                          size_t nbPartitions, std::vector<size_t> &first)
 {
-  const int nb_indices = faceIndices->nelements;
-  Alembic::Abc::V2fArraySamplePtr abcUvs =
-      uvParam.getExpandedValue(sampleInfo.floorIndex).getVals();
-  uv_map_mkey_to_int UVs_map;
-
-  // fill the map and rewrite uvsIdx
-  int new_idx = 0;
-  for (int i = 0; i < nb_indices; ++i) {
-    uv_mkey mkey;
-    mkey.vertexId = AiArrayGetUInt(faceIndices, i);
-    unsigned int uvs_id = AiArrayGetUInt(uvsIdx, i);
-    const Alembic::Abc::V2f &UV = abcUvs->get()[uvs_id];
-    mkey.uv_x = UV.x;
-    mkey.uv_y = UV.y;
-
-    if (UVs_map.find(mkey) == UVs_map.end()) {
-      UVs_map[mkey] = new_idx;
-      AiArraySetUInt(uvsIdx, i, new_idx);
-      ++new_idx;
-    }
-    else {
-      AiArraySetUInt(uvsIdx, i, UVs_map[mkey]);  // replace with the right index
+  faceVaryingTable<N> table(span, span.count / nbPartitions + 1);
+  for (size_t i = 0; i < span.count; ++i) {
+    if (span.vertexIds[i] % nbPartitions == partition) {
+      first[i] = table.findOrInsert(i);
     }
   }
+}
 
-  // fill the UVs
-  AtArray *uvs = AiArrayAllocate((AtUInt32)UVs_map.size(), 1, AI_TYPE_POINT2);
-  for (uv_map_mkey_to_int::const_iterator beg = UVs_map.begin();
-       beg != UVs_map.end(); ++beg) {
-    AtPoint2 pt;
-    pt.x = beg->first.uv_x;
-    pt.y = beg->first.uv_y;
+// below that amount of face-vertices, spawning threads costs more than it saves
+const size_t gParallelDedupThreshold = 1 << 16;
 
-    AiArraySetPnt2(uvs, beg->second, pt);
+// newIdx receives the welded index of every face-vertex, firstPos the
+// face-vertex holding each unique value, in index order.
+template <int N>
+void dedupFaceVarying(const faceVaryingSpan<N> &span,
+                      std::vector<AtUInt32> &newIdx,
+                      std::vector<size_t> &firstPos)
+{
+  std::vector<size_t> first(span.count);
+
+  size_t nbPartitions = 1;
+  if (span.count >= gParallelDedupThreshold) {
+    nbPartitions = std::max(1u, boost::thread::hardware_concurrency());
   }
-  return uvs;
-}
 
-// --------------------------------------------------------------------------------------------------
-typedef struct __n_mkey {
-  int vertexId;
-  float n_x;
-  float n_y;
-  float n_z;
-} n_mkey;
-
-class n_mkey_less : public std::binary_function<n_mkey, n_mkey, bool> {
- public:
-  bool operator()(const n_mkey &p1, const n_mkey &p2) const
-  {
-    if (p1.vertexId < p2.vertexId) {
-      return true;
-    }
-    else if (p1.vertexId > p2.vertexId) {
-      return false;
+  if (nbPartitions == 1) {
+    findFirstOccurrences(span, 0, 1, first);
+  }
+  else {
+    boost::thread_group threads;
+    for (size_t p = 0; p < nbPartitions; ++p) {
+      threads.create_thread(boost::bind(&findFirstOccurrences<N>,
+                                        boost::cref(span), p, nbPartitions,
+                                        boost::ref(first)));
     }
+    threads.join_all();
+  }
 
-    else if (p1.n_x < p2.n_x) {
-      return true;
+  // number the unique values in order of first occurrence
+  newIdx.resize(span.count);
+  firstPos.clear();
+  for (size_t i = 0; i < span.count; ++i) {
+    if (first[i] == i) {
+      newIdx[i] = (AtUInt32)firstPos.size();
+      firstPos.push_back(i);
     }
-    else if (p1.n_x > p2.n_x) {
-      return false;
+    else {
+      newIdx[i] = newIdx[first[i]];
     }
+  }
+}
 
-    else if (p1.n_y < p2.n_y) {
-      return true;
-    }
-    else if (p1.n_y > p2.n_y) {
-      return false;
-    }
+}  // namespace
 
-    return p1.n_z < p2.n_z;
+// --------------------------------------------------------------------------------------------------
+AtArray *removeUvsDuplicate(Alembic::AbcGeom::IV2fGeomParam &uvParam,
+                            SampleInfo &sampleInfo, AtArray *uvsIdx,
+                            AtArray *faceIndices)
+{
+  Alembic::Abc::V2fArraySamplePtr abcUvs =
+      uvParam.getExpandedValue(sampleInfo.floorIndex).getVals();
+
+  faceVaryingSpan<2> span;
+  span.vertexIds = (const AtUInt32 *)faceIndices->data;
+  span.valueIds = (const AtUInt32 *)uvsIdx->data;
+  span.values = (const float *)abcUvs->getData();
+  span.count = faceIndices->nelements;
+
+  std::vector<AtUInt32> newIdx;
+  std::vector<size_t> firstPos;
+  dedupFaceVarying(span, newIdx, firstPos);
+
+  // fill the UVs, uvsIdx is still the original one at this point
+  AtArray *uvs = AiArrayAllocate((AtUInt32)firstPos.size(), 1, AI_TYPE_POINT2);
+  AtPoint2 *uvsData = (AtPoint2 *)uvs->data;
+  for (size_t i = 0; i < firstPos.size(); ++i) {
+    const Alembic::Abc::V2f &UV = abcUvs->get()[span.valueIds[firstPos[i]]];
+    uvsData[i].x = UV.x;
+    uvsData[i].y = UV.y;
   }
-};
 
-typedef std::map<n_mkey, int, n_mkey_less>
-    n_map_mkey_to_int;  // a map from UVs to their respective indices!
+  // and rewrite uvsIdx
+  if (!newIdx.empty()) {
+    memcpy(uvsIdx->data, &newIdx[0], newIdx.size() * sizeof(AtUInt32));
+  }
+  return uvs;
+}
 
-static void fillNormals(AtArray *nor, AtULong &norOffset,
-                        const n_map_mkey_to_int &Ns_map)
+// --------------------------------------------------------------------------------------------------
+static void fillNormals(AtArray *nor, AtULong &norOffset, AtArray *nIdx,
+                        const faceVaryingSpan<3> &span,
+                        const std::vector<AtUInt32> &newIdx,
+                        const std::vector<size_t> &firstPos)
 {
-  for (n_map_mkey_to_int::const_iterator beg = Ns_map.begin();
-       beg != Ns_map.end(); ++beg) {
-    AtVector norm;
-    const n_mkey &first = beg->first;
-    norm.x = first.n_x;
-    norm.y = first.n_y;
-    norm.z = first.n_z;
+  AtVector *norData = (AtVector *)nor->data + norOffset;
+  for (size_t i = 0; i < firstPos.size(); ++i) {
+    const float *n = span.values + (size_t)span.valueIds[firstPos[i]] * 3;
+    norData[i].x = n[0];
+    norData[i].y = n[1];
+    norData[i].z = n[2];
+  }
 
-    AiArraySetVec(nor, norOffset + beg->second, norm);
+  // the indices are only rewritten for the first motion key
+  if (!norOffset && !newIdx.empty()) {
+    memcpy(nIdx->data, &newIdx[0], newIdx.size() * sizeof(AtUInt32));
   }
-  norOffset += (AtULong)Ns_map.size();
+  norOffset += (AtULong)firstPos.size();
 }
 
 void removeNormalsDuplicate(AtArray *nor, AtULong &norOffset,
@@ -137,34 +264,18 @@ void removeNormalsDuplicate(AtArray *nor, AtULong &norOffset,
                             SampleInfo &sampleInfo, AtArray *nIdx,
                             AtArray *faceIndices)
 {
-  const int nb_indices = faceIndices->nelements;
-  n_map_mkey_to_int Ns_map;
-
-  // fill the map and rewrite uvsIdx
-  int new_idx = 0;
-  for (int i = 0; i < nb_indices; ++i) {
-    n_mkey mkey;
-    mkey.vertexId = AiArrayGetUInt(faceIndices, i);
-    unsigned int n_id = AiArrayGetUInt(nIdx, i);
-    const Alembic::Abc::N3f &N1 = abcN->get()[n_id];
-    mkey.n_x = N1.x;
-    mkey.n_y = N1.y;
-    mkey.n_z = N1.z;
-
-    if (Ns_map.find(mkey) == Ns_map.end()) {
-      Ns_map[mkey] = new_idx;
-      if (!norOffset) {
-        AiArraySetUInt(nIdx, i, new_idx);
-      }
-      ++new_idx;
-    }
-    else if (!norOffset) {
-      AiArraySetUInt(nIdx, i, Ns_map[mkey]);  // replace with the right index
-    }
-  }
+  faceVaryingSpan<3> span;
+  span.vertexIds = (const AtUInt32 *)faceIndices->data;
+  span.valueIds = (const AtUInt32 *)nIdx->data;
+  span.values = (const float *)abcN->getData();
+  span.count = faceIndices->nelements;
+
+  std::vector<AtUInt32> newIdx;
+  std::vector<size_t> firstPos;
+  dedupFaceVarying(span, newIdx, firstPos);
 
   // fill the Ns
-  fillNormals(nor, norOffset, Ns_map);
+  fillNormals(nor, norOffset, nIdx, span, newIdx, firstPos);
 }
 
 void removeNormalsDuplicateDynTopology(AtArray *nor, AtULong &norOffset,
@@ -174,33 +285,28 @@ void removeNormalsDuplicateDynTopology(AtArray *nor, AtULong &norOffset,
                                        SampleInfo &sampleInfo, AtArray *nIdx,
                                        AtArray *faceIndices)
 {
-  const int nb_indices = faceIndices->nelements;
   const float beta = 1.0f - alpha;
-  n_map_mkey_to_int Ns_map;
-
-  // fill the map and rewrite uvsIdx
-  int new_idx = 0;
-  for (int i = 0; i < nb_indices; ++i) {
-    n_mkey mkey;
-    mkey.vertexId = AiArrayGetUInt(faceIndices, i);
-    unsigned int n_id = AiArrayGetUInt(nIdx, i);
-    const Alembic::Abc::N3f &N1 = abcN1->get()[n_id], &N2 = abcN2->get()[n_id];
-    mkey.n_x = N1.x * beta + N2.x * alpha;
-    mkey.n_y = N1.y * beta + N2.y * alpha;
-    mkey.n_z = N1.z * beta + N2.z * alpha;
-
-    if (Ns_map.find(mkey) == Ns_map.end()) {
-      Ns_map[mkey] = new_idx;
-      if (!norOffset) {
-        AiArraySetUInt(nIdx, i, new_idx);
-      }
-      ++new_idx;
-    }
-    else if (!norOffset) {
-      AiArraySetUInt(nIdx, i, Ns_map[mkey]);  // replace with the right index
-    }
+
+  // blend once per normal rather than once per face-vertex
+  const size_t nbNormals = std::min(abcN1->size(), abcN2->size());
+  std::vector<float> blended(nbNormals * 3);
+  for (size_t i = 0; i < nbNormals; ++i) {
+    const Alembic::Abc::N3f &N1 = abcN1->get()[i], &N2 = abcN2->get()[i];
+    blended[i * 3 + 0] = N1.x * beta + N2.x * alpha;
+    blended[i * 3 + 1] = N1.y * beta + N2.y * alpha;
+    blended[i * 3 + 2] = N1.z * beta + N2.z * alpha;
   }
 
+  faceVaryingSpan<3> span;
+  span.vertexIds = (const AtUInt32 *)faceIndices->data;
+  span.valueIds = (const AtUInt32 *)nIdx->data;
+  span.values = blended.empty() ? NULL : &blended[0];
+  span.count = faceIndices->nelements;
+
+  std::vector<AtUInt32> newIdx;
+  std::vector<size_t> firstPos;
+  dedupFaceVarying(span, newIdx, firstPos);
+
   // fill the Ns
-  fillNormals(nor, norOffset, Ns_map);
+  fillNormals(nor, norOffset, nIdx, span, newIdx, firstPos);
 }
@@ -20,6 +20,7 @@ static int Init(AtNode *mynode, void **user_ptr)
 
   userData *ud = new userData();
   *user_ptr = ud;
+  expansionTimer initTimer(ud->stats.initSeconds);
   ud->gProcShaders = NULL;
   ud->gProcDispMap = NULL;
 
@@ -55,6 +56,9 @@ static int Init(AtNode *mynode, void **user_ptr)
   // set defaults for options
   ud->gCurvesMode = "ribbon";
   ud->gPointsMode = "";
+  ud->gPointsLod = 1.0f;
+  ud->gPointsLodCamera.clear();
+  ud->gPointsLodDistance = 0.0f;
   ud->gMbKeys.clear();
 
   // check the data string
@@ -105,6 +109,24 @@ static int Init(AtNode *mynode, void **user_ptr)
     else if (token[0] == "pointsmode") {
       ud->gPointsMode = token[1];
     }
+    else if (token[0] == "pointslod") {
+      ud->gPointsLod = (float)atof(token[1].c_str());
+      if (ud->gPointsLod <= 0.0f || ud->gPointsLod > 1.0f) {
+        AiMsgError(
+            "[ExocortexAlembicArnold] pointslod '%s' must be in ]0, 1].",
+            token[1].c_str());
+        return NULL;
+      }
+    }
+    else if (token[0] == "pointslodcamera") {
+      ud->gPointsLodCamera = token[1];
+    }
+    else if (token[0] == "pointsloddistance") {
+      ud->gPointsLodDistance = (float)atof(token[1].c_str());
+    }
+    else if (token[0] == "statsfile") {
+      ud->stats.jsonFile = token[1];
+    }
     else if (token[0] == "mbkeys") {
       std::vector<std::string> sampleTimes;
       boost::split(sampleTimes, token[1], boost::is_any_of(";"));
@@ -156,6 +178,35 @@ static int Init(AtNode *mynode, void **user_ptr)
   if (ud->gMbKeys.size() == 0) {
     ud->gMbKeys.push_back(ud->gTime);
   }
+  if (!ud->gPointsLodCamera.empty()) {
+    if (ud->gPointsLodDistance <= 0.0f) {
+      AiMsgError(
+          "[ExocortexAlembicArnold] pointsloddistance token required by "
+          "pointslodcamera in '%s'.",
+          ud->gDataString);
+      return NULL;
+    }
+    AtNode *camera = AiNodeLookUpByName(ud->gPointsLodCamera.c_str());
+    if (camera == NULL) {
+      AiMsgWarning(
+          "[ExocortexAlembicArnold] pointslodcamera '%s' not found, using a "
+          "fixed points LOD.",
+          ud->gPointsLodCamera.c_str());
+      ud->gPointsLodCamera.clear();
+    }
+    else {
+      // bring the camera position into the procedural's space
+      AtMatrix cameraMatrix, procMatrix, procInverse;
+      AiNodeGetMatrix(camera, "matrix", cameraMatrix);
+      AiNodeGetMatrix(mynode, "matrix", procMatrix);
+      AiM4Invert(procMatrix, procInverse);
+      AtPoint cameraPos;
+      cameraPos.x = cameraMatrix[3][0];
+      cameraPos.y = cameraMatrix[3][1];
+      cameraPos.z = cameraMatrix[3][2];
+      AiM4PointByMatrixMult(&ud->gPointsLodCameraPos, procInverse, &cameraPos);
+    }
+  }
 
   // fix all paths
   for (size_t pathIndex = 0; pathIndex < paths.size(); pathIndex++) {
@@ -252,6 +303,9 @@ static int Init(AtNode *mynode, void **user_ptr)
     paths[pathIndex] = result;
   }
 
+  ud->stats.path = paths[0];
+  ud->stats.identifier = identifier;
+
   AiMsgDebug("[ExocortexAlembicArnold] path used: %s", paths[0].c_str());
   AiMsgDebug("[ExocortexAlembicArnold] identifier used: %s",
              identifier.c_str());
@@ -800,6 +854,8 @@ static int Cleanup(void *user_ptr)
   GLOBAL_LOCK;
   userData *ud = (userData *)user_ptr;
 
+  ud->stats.report();
+
   ud->gIObjects.clear();
   ud->gInstances.clear();
   ud->gMbKeys.clear();
@@ -828,6 +884,10 @@ static AtNode *GetNode(void *user_ptr, int i)
     return NULL;
   }
 
+  // the time is accounted to the right object type once it is known
+  expansionStats::nodeType statsType = expansionStats::OTHER;
+  expansionTimer getNodeTimer(ud->stats.getNodeSeconds[statsType]);
+
   nodeData nodata;  // contain basic information common in all types of data!
 
   // construct the timesamples
@@ -846,7 +906,13 @@ static AtNode *GetNode(void *user_ptr, int i)
 
   // now check if this is supposed to be an instance
   if (ud->gIObjects[i].instanceID > -1) {
-    return createInstanceNode(nodata, ud, i);
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[expansionStats::INSTANCE]);
+    ++ud->stats.getNodeCalls[expansionStats::INSTANCE];
+    AtNode *instanceNode = createInstanceNode(nodata, ud, i);
+    if (instanceNode != NULL) {
+      ++ud->stats.nodesCreated;
+    }
+    return instanceNode;
   }
 
   nodata.shaders = NULL;
@@ -861,18 +927,28 @@ static AtNode *GetNode(void *user_ptr, int i)
 
   const Alembic::Abc::MetaData &md = nodata.object.getMetaData();
   if (Alembic::AbcGeom::IPolyMesh::matches(md)) {
+    statsType = expansionStats::POLYMESH;
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[statsType]);
     shapeNode = createPolyMeshNode(nodata, ud, nodata.samples, i);
   }
   else if (Alembic::AbcGeom::ISubD::matches(md)) {
+    statsType = expansionStats::SUBD;
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[statsType]);
     shapeNode = createSubDNode(nodata, ud, nodata.samples, i);
   }
   else if (Alembic::AbcGeom::ICurves::matches(md)) {
+    statsType = expansionStats::CURVES;
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[statsType]);
     shapeNode = createCurvesNode(nodata, ud, nodata.samples, i);
   }
   else if (Alembic::AbcGeom::INuPatch::matches(md)) {
+    statsType = expansionStats::NURBS;
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[statsType]);
     shapeNode = createNurbsNode(nodata, ud, nodata.samples, i);
   }
   else if (Alembic::AbcGeom::IPoints::matches(md)) {
+    statsType = expansionStats::POINTS;
+    getNodeTimer.retarget(ud->stats.getNodeSeconds[statsType]);
     shapeNode = createPointsNode(nodata, ud, nodata.samples, i);
   }
   else if (Alembic::AbcGeom::ICamera::matches(md)) {
@@ -883,8 +959,12 @@ static AtNode *GetNode(void *user_ptr, int i)
         "[ExocortexAlembicArnold] This object type is not supported: '%s'.",
         md.get("schema").c_str());
 
+  ++ud->stats.getNodeCalls[statsType];
+
   // if we have a shape
   if (shapeNode != NULL) {
+    ++ud->stats.nodesCreated;
+    ud->stats.addGeometry(shapeNode, statsType);
     ud->constructedNodes.push_back(shapeNode);
     if (nodata.shaders != NULL) {
       ud->shadersToAssign.push_back(AiArrayCopy(nodata.shaders));
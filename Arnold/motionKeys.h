@@ -0,0 +1,103 @@
+#ifndef _ARNOLD_ALEMBIC_MOTION_KEYS_H_
+#define _ARNOLD_ALEMBIC_MOTION_KEYS_H_
+
+#include "common.h"
+
+/**
+ * Resolves the samples needed by all the motion keys of a shape at once.
+ *
+ * Consecutive motion keys very often fall in the same sample interval (the
+ * ceil sample of one key is the floor of the next, sub-frame keys share both),
+ * so instead of fetching floor and ceil samples for every key, the unique
+ * sample indices are collected first and every schema sample is read once.
+ * The ceil sample is only read for keys that actually need to interpolate.
+ */
+template <typename SCHEMA>
+class motionKeyReader {
+ public:
+  typedef typename SCHEMA::Sample sample_type;
+
+  // keyTimes holds the time of each motion key, only the first nbKeys are
+  // used. If readCeil is false, only the floor samples are read.
+  motionKeyReader(SCHEMA &schema, const std::vector<float> &keyTimes,
+                  size_t nbKeys, bool readCeil = true)
+  {
+    mInfos.resize(nbKeys);
+    for (size_t k = 0; k < nbKeys; ++k) {
+      mInfos[k] = getSampleInfo(keyTimes[k], schema.getTimeSampling(),
+                                schema.getNumSamples());
+    }
+    resolve(schema, readCeil);
+  }
+
+  size_t numKeys() const { return mInfos.size(); }
+  size_t numUniqueSamples() const { return mSamples.size(); }
+  size_t numRequestedSamples() const { return mNbRequested; }
+
+  // accounts the samples read in the procedural's stats
+  void addToStats(expansionStats &stats) const
+  {
+    stats.samplesRequested += mNbRequested;
+    stats.samplesRead += mSamples.size();
+  }
+
+  SampleInfo &info(size_t key) { return mInfos[key]; }
+
+  bool needsInterpolation(size_t key) const
+  {
+    return mInfos[key].alpha > sampleTolerance;
+  }
+
+  sample_type &floorSample(size_t key) { return mSamples[mFloorSlots[key]]; }
+
+  // only valid if needsInterpolation(key) and the ceil samples were read
+  sample_type &ceilSample(size_t key) { return mSamples[mCeilSlots[key]]; }
+
+ private:
+  void resolve(SCHEMA &schema, bool readCeil)
+  {
+    std::map<Alembic::AbcCoreAbstract::index_t, size_t> slots;
+    mFloorSlots.resize(mInfos.size());
+    mCeilSlots.resize(mInfos.size());
+    mNbRequested = 0;
+    for (size_t k = 0; k < mInfos.size(); ++k) {
+      mFloorSlots[k] = slotOf(slots, mInfos[k].floorIndex);
+      mCeilSlots[k] = mFloorSlots[k];
+      ++mNbRequested;
+      if (readCeil && needsInterpolation(k)) {
+        mCeilSlots[k] = slotOf(slots, mInfos[k].ceilIndex);
+        ++mNbRequested;
+      }
+    }
+
+    // read every unique sample once
+    mSamples.resize(slots.size());
+    for (std::map<Alembic::AbcCoreAbstract::index_t, size_t>::const_iterator
+             it = slots.begin();
+         it != slots.end(); ++it) {
+      schema.get(mSamples[it->second], it->first);
+    }
+  }
+
+  static size_t slotOf(
+      std::map<Alembic::AbcCoreAbstract::index_t, size_t> &slots,
+      Alembic::AbcCoreAbstract::index_t index)
+  {
+    std::map<Alembic::AbcCoreAbstract::index_t, size_t>::iterator it =
+        slots.find(index);
+    if (it != slots.end()) {
+      return it->second;
+    }
+    const size_t slot = slots.size();
+    slots.insert(std::make_pair(index, slot));
+    return slot;
+  }
+
+  std::vector<SampleInfo> mInfos;
+  std::vector<size_t> mFloorSlots;
+  std::vector<size_t> mCeilSlots;
+  std::vector<sample_type> mSamples;
+  size_t mNbRequested;
+};
+
+#endif
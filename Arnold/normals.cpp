@@ -0,0 +1,146 @@
+#include "stdafx.h"
+
+#include "normals.h"
+
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+// below that amount of faces, spawning threads costs more than it saves
+static const size_t gParallelNormalsThreshold = 1 << 15;
+
+static size_t getNbThreads(size_t count)
+{
+  if (count < gParallelNormalsThreshold) {
+    return 1;
+  }
+  return std::max(1u, boost::thread::hardware_concurrency());
+}
+
+vertexNormalsGenerator::vertexNormalsGenerator(
+    const Alembic::Abc::Int32ArraySamplePtr &faceCounts,
+    const Alembic::Abc::Int32ArraySamplePtr &faceIndices, size_t nbVertices)
+    : mFaceCounts(faceCounts->get()),
+      mFaceIndices(faceIndices->get()),
+      mFaceCountsSample(faceCounts),
+      mFaceIndicesSample(faceIndices),
+      mNbFaces(faceCounts->size()),
+      mNbVertices(nbVertices)
+{
+  const size_t nbFaceVertices = faceIndices->size();
+
+  // face offsets, and the number of faces using each vertex
+  mFaceOffsets.resize(mNbFaces + 1);
+  mVertexOffsets.assign(mNbVertices + 1, 0);
+  size_t offset = 0;
+  for (size_t f = 0; f < mNbFaces; ++f) {
+    mFaceOffsets[f] = offset;
+    const size_t end = std::min(offset + (size_t)mFaceCounts[f], nbFaceVertices);
+    for (size_t j = offset; j < end; ++j) {
+      const size_t v = (size_t)mFaceIndices[j];
+      if (v < mNbVertices) {
+        ++mVertexOffsets[v + 1];
+      }
+    }
+    offset = end;
+  }
+  mFaceOffsets[mNbFaces] = offset;
+
+  // vertex to face table
+  for (size_t v = 0; v < mNbVertices; ++v) {
+    mVertexOffsets[v + 1] += mVertexOffsets[v];
+  }
+  mVertexFaces.resize(mVertexOffsets[mNbVertices]);
+  std::vector<size_t> fill(mVertexOffsets.begin(), mVertexOffsets.end() - 1);
+  for (size_t f = 0; f < mNbFaces; ++f) {
+    for (size_t j = mFaceOffsets[f]; j < mFaceOffsets[f + 1]; ++j) {
+      const size_t v = (size_t)mFaceIndices[j];
+      if (v < mNbVertices) {
+        mVertexFaces[fill[v]++] = (AtUInt32)f;
+      }
+    }
+  }
+
+  mFaceNormals.resize(mNbFaces * 3);
+}
+
+void vertexNormalsGenerator::computeFaceNormals(const float *positions,
+                                                size_t begin,
+                                                size_t end) const
+{
+  for (size_t f = begin; f < end; ++f) {
+    const size_t first = mFaceOffsets[f];
+    const size_t last = mFaceOffsets[f + 1];
+    float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+    for (size_t j = first; j < last; ++j) {
+      const size_t k = j + 1 < last ? j + 1 : first;
+      const size_t vc = (size_t)mFaceIndices[j];
+      const size_t vn = (size_t)mFaceIndices[k];
+      if (vc >= mNbVertices || vn >= mNbVertices) {
+        continue;
+      }
+      const float *c = positions + vc * 3;
+      const float *n = positions + vn * 3;
+      nx += (c[2] + n[2]) * (c[1] - n[1]);
+      ny += (c[0] + n[0]) * (c[2] - n[2]);
+      nz += (c[1] + n[1]) * (c[0] - n[0]);
+    }
+
+    // the Alembic winding is reversed when handed to Arnold
+    mFaceNormals[f * 3 + 0] = -nx;
+    mFaceNormals[f * 3 + 1] = -ny;
+    mFaceNormals[f * 3 + 2] = -nz;
+  }
+}
+
+void vertexNormalsGenerator::accumulateVertexNormals(float *normals,
+                                                     size_t begin,
+                                                     size_t end) const
+{
+  const float *faceNormals = mFaceNormals.empty() ? NULL : &mFaceNormals[0];
+  for (size_t v = begin; v < end; ++v) {
+    float nx = 0.0f, ny = 0.0f, nz = 0.0f;
+    for (size_t a = mVertexOffsets[v]; a < mVertexOffsets[v + 1]; ++a) {
+      const float *fn = faceNormals + (size_t)mVertexFaces[a] * 3;
+      nx += fn[0];
+      ny += fn[1];
+      nz += fn[2];
+    }
+    const float len2 = nx * nx + ny * ny + nz * nz;
+    const float inv = len2 > 0.0f ? 1.0f / sqrtf(len2) : 0.0f;
+    normals[v * 3 + 0] = nx * inv;
+    normals[v * 3 + 1] = ny * inv;
+    normals[v * 3 + 2] = nz * inv;
+  }
+}
+
+void vertexNormalsGenerator::compute(const float *positions,
+                                     float *normals) const
+{
+  const size_t nbThreads = getNbThreads(mNbFaces);
+  if (nbThreads == 1) {
+    computeFaceNormals(positions, 0, mNbFaces);
+    accumulateVertexNormals(normals, 0, mNbVertices);
+    return;
+  }
+
+  {
+    boost::thread_group threads;
+    const size_t chunk = (mNbFaces + nbThreads - 1) / nbThreads;
+    for (size_t begin = 0; begin < mNbFaces; begin += chunk) {
+      threads.create_thread(
+          boost::bind(&vertexNormalsGenerator::computeFaceNormals, this,
+                      positions, begin, std::min(begin + chunk, mNbFaces)));
+    }
+    threads.join_all();
+  }
+  {
+    boost::thread_group threads;
+    const size_t chunk = (mNbVertices + nbThreads - 1) / nbThreads;
+    for (size_t begin = 0; begin < mNbVertices; begin += chunk) {
+      threads.create_thread(
+          boost::bind(&vertexNormalsGenerator::accumulateVertexNormals, this,
+                      normals, begin, std::min(begin + chunk, mNbVertices)));
+    }
+    threads.join_all();
+  }
+}
@@ -0,0 +1,46 @@
+#ifndef _ARNOLD_ALEMBIC_NORMALS_H_
+#define _ARNOLD_ALEMBIC_NORMALS_H_
+
+#include "common.h"
+
+/**
+ * Smooth vertex normals for meshes exported without normals.
+ *
+ * The topology is analysed once (face offsets and a vertex to face table), so
+ * the same generator can be used for every motion key. Face normals are
+ * computed with Newell's method, vertex normals are the normalized sum of the
+ * normals of the adjacent faces (so they are area weighted). Large meshes are
+ * split across threads, by faces then by vertices, without any shared write.
+ */
+class vertexNormalsGenerator {
+ public:
+  vertexNormalsGenerator(const Alembic::Abc::Int32ArraySamplePtr &faceCounts,
+                         const Alembic::Abc::Int32ArraySamplePtr &faceIndices,
+                         size_t nbVertices);
+
+  size_t numVertices() const { return mNbVertices; }
+
+  // positions and normals both hold numVertices() packed xyz triplets. The
+  // normals follow Arnold's winding, which is the reverse of Alembic's.
+  void compute(const float *positions, float *normals) const;
+
+ private:
+  void computeFaceNormals(const float *positions, size_t begin,
+                          size_t end) const;
+  void accumulateVertexNormals(float *normals, size_t begin, size_t end) const;
+
+  const Alembic::Abc::int32_t *mFaceCounts;
+  const Alembic::Abc::int32_t *mFaceIndices;
+  Alembic::Abc::Int32ArraySamplePtr mFaceCountsSample;
+  Alembic::Abc::Int32ArraySamplePtr mFaceIndicesSample;
+  size_t mNbFaces;
+  size_t mNbVertices;
+
+  std::vector<size_t> mFaceOffsets;    // first face-vertex of each face
+  std::vector<size_t> mVertexOffsets;  // CSR offsets into mVertexFaces
+  std::vector<AtUInt32> mVertexFaces;  // faces adjacent to each vertex
+
+  mutable std::vector<float> mFaceNormals;
+};
+
+#endif
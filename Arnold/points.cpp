@@ -1,6 +1,118 @@
 #include "stdafx.h"
 
 #include "points.h"
+#include "motionKeys.h"
+
+// deterministic value in [0, 1) for a particle id, so the same particles are
+// kept on every frame
+static float hashParticleId(Alembic::Util::uint64_t id)
+{
+  id += 0x9e3779b97f4a7c15ULL;
+  id = (id ^ (id >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  id = (id ^ (id >> 27)) * 0x94d049bb133111ebULL;
+  id ^= id >> 31;
+  return (float)(id >> 40) / (float)(1 << 24);
+}
+
+// the particles kept by the points LOD, with the factor applied to their
+// radius so that the decimated cloud still covers the same area
+struct pointsLod {
+  bool enabled;
+  std::vector<AtUInt32> kept;
+  std::vector<float> radiusScale;
+
+  pointsLod() : enabled(false) {}
+
+  size_t count(size_t nbPoints) const
+  {
+    return enabled ? kept.size() : nbPoints;
+  }
+  size_t index(size_t i) const { return enabled ? (size_t)kept[i] : i; }
+  float scale(size_t i) const { return enabled ? radiusScale[i] : 1.0f; }
+};
+
+static void decimatePoints(userData *ud,
+                           const Alembic::Abc::P3fArraySamplePtr &abcPos,
+                           const Alembic::Abc::UInt64ArraySamplePtr &abcIds,
+                           pointsLod &lod)
+{
+  const bool useCamera = !ud->gPointsLodCamera.empty();
+  lod.enabled = ud->gPointsLod < 1.0f || useCamera;
+  if (!lod.enabled) {
+    return;
+  }
+
+  const size_t nbPoints = abcPos->size();
+  const bool useIds = abcIds && abcIds->size() == nbPoints;
+  const AtPoint &cam = ud->gPointsLodCameraPos;
+  const float dist2 = ud->gPointsLodDistance * ud->gPointsLodDistance;
+  for (size_t i = 0; i < nbPoints; ++i) {
+    // keep the projected density constant when driven by the camera
+    float ratio = ud->gPointsLod;
+    if (useCamera) {
+      const Alembic::Abc::V3f &p = abcPos->get()[i];
+      const float dx = p.x - cam.x, dy = p.y - cam.y, dz = p.z - cam.z;
+      const float d2 = dx * dx + dy * dy + dz * dz;
+      ratio = d2 > 0.0f ? std::min(1.0f, ratio * dist2 / d2) : 1.0f;
+    }
+
+    const Alembic::Util::uint64_t id =
+        useIds ? abcIds->get()[i] : (Alembic::Util::uint64_t)i;
+    if (hashParticleId(id) < ratio) {
+      lod.kept.push_back((AtUInt32)i);
+      lod.radiusScale.push_back(1.0f / sqrtf(ratio));
+    }
+  }
+}
+
+// the particles of a motion key matching the ones kept at the first key.
+// They are matched by id when the count or the order of the particles changed
+// since the first key, -1 when a particle is not in the key. The ids of the
+// kept particles are sorted once in keptSlots, every key then only walks its
+// own ids.
+typedef std::pair<Alembic::Util::uint64_t, size_t> keptSlot;
+
+static void matchKeptPoints(const pointsLod &lod, size_t nbKept,
+                            const Alembic::Abc::UInt64ArraySamplePtr &firstIds,
+                            const Alembic::Abc::UInt64ArraySamplePtr &keyIds,
+                            size_t nbPoints, std::vector<keptSlot> &keptSlots,
+                            std::vector<long> &indices)
+{
+  indices.resize(nbKept);
+  const bool validIds = firstIds && keyIds && keyIds->size() == nbPoints;
+  const bool sameIds =
+      validIds && firstIds->size() == nbPoints &&
+      (firstIds == keyIds ||
+       std::equal(firstIds->get(), firstIds->get() + nbPoints, keyIds->get()));
+  if (sameIds || !validIds) {
+    for (size_t i = 0; i < nbKept; ++i) {
+      const size_t index = lod.index(i);
+      indices[i] = index < nbPoints ? (long)index : -1;
+    }
+    return;
+  }
+
+  if (keptSlots.empty()) {
+    keptSlots.reserve(nbKept);
+    for (size_t i = 0; i < nbKept; ++i) {
+      const size_t index = lod.index(i);
+      if (index < firstIds->size()) {
+        keptSlots.push_back(keptSlot(firstIds->get()[index], i));
+      }
+    }
+    std::sort(keptSlots.begin(), keptSlots.end());
+  }
+
+  std::fill(indices.begin(), indices.end(), -1L);
+  for (size_t i = 0; i < nbPoints; ++i) {
+    const Alembic::Util::uint64_t id = keyIds->get()[i];
+    std::vector<keptSlot>::const_iterator it = std::lower_bound(
+        keptSlots.begin(), keptSlots.end(), keptSlot(id, 0));
+    for (; it != keptSlots.end() && it->first == id; ++it) {
+      indices[it->second] = (long)i;
+    }
+  }
+}
 
 AtNode *createPointsNode(nodeData &nodata, userData *ud,
                          std::vector<float> &samples, int i)
@@ -17,17 +129,25 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
   // create arrays to hold the data
   AtArray *pos = NULL;
   nodata.shifted = false;
+  pointsLod lod;
 
   // loop over all samples
   AtULong posOffset = 0;
+  size_t nbKept = 0;
+  Alembic::Abc::UInt64ArraySamplePtr firstIds;
+  std::vector<keptSlot> keptSlots;
+  std::vector<long> indices;
+
+  // points are extrapolated with their velocities, the floor sample is enough
+  motionKeyReader<Alembic::AbcGeom::IPointsSchema> keys(
+      typedObject.getSchema(), samples, minNumSamples, false);
+  keys.addToStats(ud->stats);
   for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
-    SampleInfo sampleInfo = getSampleInfo(
-        samples[sampleIndex], typedObject.getSchema().getTimeSampling(),
-        typedObject.getSchema().getNumSamples());
+    SampleInfo &sampleInfo = keys.info(sampleIndex);
 
     // get the floor sample
-    Alembic::AbcGeom::IPointsSchema::Sample sample;
-    typedObject.getSchema().get(sample, sampleInfo.floorIndex);
+    Alembic::AbcGeom::IPointsSchema::Sample &sample =
+        keys.floorSample(sampleIndex);
 
     // access the points
     Alembic::Abc::P3fArraySamplePtr abcPos = sample.getPositions();
@@ -39,6 +159,18 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
         AiNodeSetStr(shapeNode, "mode", ud->gPointsMode.c_str());
       }
 
+      // select the particles to keep, all of them without LOD
+      firstIds = sample.getIds();
+      decimatePoints(ud, abcPos, firstIds, lod);
+      nbKept = lod.count(abcPos->size());
+      if (lod.enabled) {
+        AiMsgInfo(
+            "[ExocortexAlembicArnold] Points LOD kept %u of %u particles of "
+            "%s.",
+            (unsigned int)lod.kept.size(), (unsigned int)abcPos->size(),
+            nodata.object.getFullName().c_str());
+      }
+
       // check if we have a radius
       Alembic::AbcGeom::IFloatGeomParam widthParam =
           typedObject.getSchema().getWidthsParam();
@@ -46,9 +178,21 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
       if (widthParam.valid()) {
         Alembic::Abc::FloatArraySamplePtr abcRadius =
             widthParam.getExpandedValue(sampleInfo.floorIndex).getVals();
-        radius = AiArrayAllocate((AtInt)abcRadius->size(), 1, AI_TYPE_FLOAT);
-        for (size_t i = 0; i < abcRadius->size(); ++i) {
-          AiArraySetFlt(radius, (AtULong)i, abcRadius->get()[i]);
+        if (lod.enabled && abcRadius->size() > 0) {
+          const size_t nbKept = lod.count(abcPos->size());
+          const size_t last = abcRadius->size() - 1;
+          radius = AiArrayAllocate((AtInt)nbKept, 1, AI_TYPE_FLOAT);
+          for (size_t i = 0; i < nbKept; ++i) {
+            const float r = abcRadius->get()[std::min(lod.index(i), last)];
+            AiArraySetFlt(radius, (AtULong)i, r * lod.scale(i));
+          }
+        }
+        else {
+          radius =
+              AiArrayAllocate((AtInt)abcRadius->size(), 1, AI_TYPE_FLOAT);
+          for (size_t i = 0; i < abcRadius->size(); ++i) {
+            AiArraySetFlt(radius, (AtULong)i, abcRadius->get()[i]);
+          }
         }
       }
       else {
@@ -56,10 +200,10 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
             "[ExocortexAlembicArnold] Point %s doesn't have \"radius\" "
             "information, defaulting the value to 0.1!",
             nodata.object.getFullName().c_str());
-        const int sz = abcPos->size();
+        const int sz = (int)lod.count(abcPos->size());
         radius = AiArrayAllocate(sz, 1, AI_TYPE_FLOAT);
         for (int i = 0; i < sz; ++i) {
-          AiArraySetFlt(radius, (AtULong)i, 0.1f);
+          AiArraySetFlt(radius, (AtULong)i, 0.1f * lod.scale(i));
         }
       }
       AiNodeSetArray(shapeNode, "radius", radius);
@@ -78,13 +222,17 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
           result = AiNodeDeclare(shapeNode, "Color", "uniform RGBA");
         }
 
+        // per particle colors follow the LOD
+        const bool decimated =
+            lod.enabled && abcColors->size() == abcPos->size();
+        const size_t nbColors =
+            decimated ? lod.count(abcPos->size()) : abcColors->size();
         if (result) {
-          AtArray *colors =
-              AiArrayAllocate((AtInt)abcColors->size(), 1, AI_TYPE_RGBA);
+          AtArray *colors = AiArrayAllocate((AtInt)nbColors, 1, AI_TYPE_RGBA);
           AtRGBA color;
-          for (size_t i = 0; i < abcColors->size(); ++i) {
+          for (size_t i = 0; i < nbColors; ++i) {
             const Alembic::Abc::C4fArraySamplePtr::element_type::value_type
-                &col = abcColors->get()[i];
+                &col = abcColors->get()[decimated ? lod.index(i) : i];
             color.r = col.r;
             color.g = col.g;
             color.b = col.b;
@@ -110,34 +258,48 @@ AtNode *createPointsNode(nodeData &nodata, userData *ud,
       }
     }
 
-    // access the positions
+    // access the positions, the particles of every key follow the ones kept
+    // at the first key
+    matchKeptPoints(lod, nbKept, firstIds, sample.getIds(), abcPos->size(),
+                    keptSlots, indices);
     if (pos == NULL)
-      pos = AiArrayAllocate((AtInt)(abcPos->size() * 3), (AtInt)minNumSamples,
+      pos = AiArrayAllocate((AtInt)(nbKept * 3), (AtInt)minNumSamples,
                             AI_TYPE_FLOAT);
 
     // if we have to interpolate
-    if (sampleInfo.alpha <= sampleTolerance) {
-      for (size_t i = 0; i < abcPos->size(); ++i) {
-        const Alembic::Abc::P3fArraySamplePtr::element_type::value_type &apos =
-            abcPos->get()[i];
-        AiArraySetFlt(pos, posOffset++, apos.x);
-        AiArraySetFlt(pos, posOffset++, apos.y);
-        AiArraySetFlt(pos, posOffset++, apos.z);
+    const float timeAlpha = sampleInfo.alpha <= sampleTolerance
+                                ? 0.0f
+                                : getTimeOffsetFromObject(typedObject,
+                                                          sampleInfo);
+    Alembic::Abc::V3fArraySamplePtr abcVel = sample.getVelocities();
+    const bool useVel = timeAlpha != 0.0f && abcVel &&
+                        abcVel->size() == abcPos->size();
+    for (size_t i = 0; i < nbKept; ++i) {
+      const long index = indices[i];
+      if (index < 0) {
+        // a particle missing from this key stays where it was at the
+        // previous one
+        for (int c = 0; c < 3; ++c, ++posOffset) {
+          AiArraySetFlt(pos, posOffset,
+                        AiArrayGetFlt(pos, posOffset - (AtULong)(nbKept * 3)));
+        }
+        continue;
       }
-    }
-    else {
-      const float timeAlpha = getTimeOffsetFromObject(typedObject, sampleInfo);
-
-      Alembic::Abc::V3fArraySamplePtr abcVel = sample.getVelocities();
-      for (size_t i = 0; i < abcPos->size(); ++i) {
-        const Alembic::Abc::P3fArraySamplePtr::element_type::value_type &apos =
-            abcPos->get()[i];
-        const Alembic::Abc::V3fArraySamplePtr::element_type::value_type &avel =
-            abcVel->get()[i];
+
+      const Alembic::Abc::P3fArraySamplePtr::element_type::value_type &apos =
+          abcPos->get()[index];
+      if (useVel) {
+        const Alembic::Abc::V3fArraySamplePtr::element_type::value_type
+            &avel = abcVel->get()[index];
         AiArraySetFlt(pos, posOffset++, apos.x + timeAlpha * avel.x);
         AiArraySetFlt(pos, posOffset++, apos.y + timeAlpha * avel.y);
         AiArraySetFlt(pos, posOffset++, apos.z + timeAlpha * avel.z);
       }
+      else {
+        AiArraySetFlt(pos, posOffset++, apos.x);
+        AiArraySetFlt(pos, posOffset++, apos.y);
+        AiArraySetFlt(pos, posOffset++, apos.z);
+      }
     }
   }
 
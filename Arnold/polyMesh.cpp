@@ -1,6 +1,8 @@
 #include "stdafx.h"
 
 #include "polyMesh.h"
+#include "motionKeys.h"
+#include "normals.h"
 
 struct __indices {
   AtArray *faceIndices;
@@ -19,53 +21,6 @@ static bool usingDynamicTopology(AbcGeom &typedObject)
 }
 
 
-void point_normal(__indices &indices, const Alembic::Abc::Int32ArraySamplePtr &abcFaceCounts, const Alembic::Abc::Int32ArraySamplePtr &abcFaceIndices,  const AtArray *vertices, AtArray *norm, AtArray *normalsIds)
-{
-
-   AiMsgWarning(
-        "[DEBBUG ExocortexAlembicArnold] vertCount '%u'| faceVertexIndxCount '%u'\n",
-        AiArrayGetUInt(indices.indices, 0),  AiArrayGetUInt(indices.indices, 1));
-  unsigned int offset = 0;
-  unsigned int facesCount = abcFaceCounts->size();
-  AtArray* normals = AiArrayAllocate(norm->nelements, 1, AI_TYPE_POINT);
-
-  for (int i = 0; i < facesCount; i++) 
-	{
-    int faceVtxCount = abcFaceCounts->get()[i];
-
-     AtVector normal = AtVector();
-
-    for (int j=offset, k = offset + 1; j < offset+faceVtxCount; j++, k++)
-    {
-	    if (k == offset+faceVtxCount) k = offset;
-
-     AtPoint current = AiArrayGetPnt(vertices, AiArrayGetUInt(indices.faceIndices, j));
-     AtPoint next = AiArrayGetPnt(vertices, AiArrayGetUInt(indices.faceIndices, k));
-
-	    normal.x += ((current.z + next.z) * (current.y - next.y));
-	    normal.y += ((current.x + next.x) * (current.z - next.z));
-	    normal.z += ((current.y + next.y) * (current.x - next.x));
-
-    }
-
-    for (int j=offset; j< offset + faceVtxCount; j++)
-    {
-      AiArraySetVec(normals, AiArrayGetUInt(indices.faceIndices, j), AiArrayGetVec(normals, AiArrayGetUInt(indices.faceIndices, j)) + normal);
-      AiArraySetUInt(normalsIds, j, AiArrayGetUInt(indices.faceIndices, j));
-    }
-    offset+=faceVtxCount;
-  }
-
-  for (int i = 0; i < normals->nelements; i++) 
-	{   
-      AiArraySetVec(normals, i, AiV3Normalize(AiArrayGetVec(normals,i)));
-	}
-  AiArraySetKey(norm, 0, normals->data);
-  AiArraySetKey(norm, 1, normals->data);
-}
-
-
-
 // common function for PolyMesh and SubD!
 static bool faceCount(AtNode *shapeNode, __indices &ind,
                       Alembic::Abc::Int32ArraySamplePtr &abcFaceCounts,
@@ -218,14 +173,15 @@ static void plainPositionCopy(AtArray *pos,
 }
 
 // IF pos == NULL, it needs to be done before calling that function
-template <typename SCHEMA, typename SCHEMA_SAMPLE>
-static bool hadToInterpolatePositions(size_t sampleIndex, SCHEMA &schema, SCHEMA_SAMPLE &sample,
+template <typename SCHEMA>
+static bool hadToInterpolatePositions(size_t sampleIndex, SCHEMA &schema,
+                                      motionKeyReader<SCHEMA> &keys,
                                       AtArray *pos, AtULong &posOffset,
                                       std::vector<float> &samples,
-                                      SampleInfo &sampleInfo,
-                                      float currentTime,
                                       bool dynamicTopology)
 {
+  typename SCHEMA::Sample &sample = keys.floorSample(sampleIndex);
+  SampleInfo &sampleInfo = keys.info(sampleIndex);
   Alembic::Abc::P3fArraySamplePtr abcPos = sample.getPositions();
 
   // if we have to interpolate
@@ -234,13 +190,11 @@ static bool hadToInterpolatePositions(size_t sampleIndex, SCHEMA &schema, SCHEMA
     return false;
   }
   else {
-    SCHEMA_SAMPLE sample2;
-    schema.get(sample2, sampleInfo.ceilIndex);
-    Alembic::Abc::P3fArraySamplePtr abcPos2 = sample2.getPositions();
-    const float alpha = (float)sampleInfo.alpha;
-    const float ialpha = 1.0f - alpha;
-
     if (!dynamicTopology) {
+      Alembic::Abc::P3fArraySamplePtr abcPos2 =
+          keys.ceilSample(sampleIndex).getPositions();
+      const float alpha = (float)sampleInfo.alpha;
+      const float ialpha = 1.0f - alpha;
 
       for (size_t i = 0; i < abcPos->size(); i++) {
         AtPoint pt;
@@ -290,6 +244,25 @@ static bool hadToInterpolatePositions(size_t sampleIndex, SCHEMA &schema, SCHEMA
   return true;
 }
 
+// expanded normals of a sample, read once even if several motion keys use it
+static Alembic::Abc::N3fArraySamplePtr getNormalsOfSample(
+    Alembic::AbcGeom::IN3fGeomParam &normalParam,
+    Alembic::AbcCoreAbstract::index_t index,
+    std::map<Alembic::AbcCoreAbstract::index_t,
+             Alembic::Abc::N3fArraySamplePtr> &normalsCache)
+{
+  std::map<Alembic::AbcCoreAbstract::index_t,
+           Alembic::Abc::N3fArraySamplePtr>::iterator it =
+      normalsCache.find(index);
+  if (it != normalsCache.end()) {
+    return it->second;
+  }
+  Alembic::Abc::N3fArraySamplePtr normals =
+      normalParam.getExpandedValue(index).getVals();
+  normalsCache[index] = normals;
+  return normals;
+}
+
 AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
                            std::vector<float> &samples, int i)
 {
@@ -301,12 +274,11 @@ AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
 
   Alembic::AbcGeom::IN3fGeomParam normalParam = typedObject.getSchema().getNormalsParam();
   if (!normalParam.valid()) {
-    AiMsgWarning(
-        "[ExocortexAlembicArnold] Mesh '%s' does not contain normals. Normals will be generated "
-        "mesh: ",
+    AiMsgDebug(
+        "[ExocortexAlembicArnold] Mesh '%s' does not contain normals. Normals "
+        "will be generated.",
         nodata.object.getFullName().c_str());
     haveNormals = false;
-    //return NULL;
   }
 
   shiftedProcessing(nodata, ud);
@@ -331,22 +303,30 @@ AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
   Alembic::Abc::Int32ArraySamplePtr abcFaceIndices;
 
   __indices ind;
-  for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
-    SampleInfo sampleInfo = getSampleInfo(
-    samples[sampleIndex], typedObject.getSchema().getTimeSampling(),
-    typedObject.getSchema().getNumSamples());
-
-    if (dynamicTopology) {
-      Alembic::Abc::TimeSamplingPtr timeSampling = typedObject.getSchema().getTimeSampling();
-      sampleInfo = getSampleInfo(ud->gCurrTime, typedObject.getSchema().getTimeSampling(), typedObject.getSchema().getNumSamples());
 
+  // with dynamic topology, all keys use the current time and we don't
+  // interpolate, the velocities are applied directly
+  const std::vector<float> keyTimes =
+      dynamicTopology ? std::vector<float>(minNumSamples, ud->gCurrTime)
+                      : samples;
+  motionKeyReader<Alembic::AbcGeom::IPolyMeshSchema> keys(
+      typedObject.getSchema(), keyTimes, minNumSamples, !dynamicTopology);
+  keys.addToStats(ud->stats);
+  if (dynamicTopology) {
+    for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
       // we don't really care about that as we directly get it
-      sampleInfo.alpha = 0;
+      keys.info(sampleIndex).alpha = 0;
     }
+  }
+  std::map<Alembic::AbcCoreAbstract::index_t, Alembic::Abc::N3fArraySamplePtr>
+      normalsCache;
+
+  for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
+    SampleInfo &sampleInfo = keys.info(sampleIndex);
 
     // get the floor sample
-    Alembic::AbcGeom::IPolyMeshSchema::Sample sample;
-    typedObject.getSchema().get(sample, sampleInfo.floorIndex);
+    Alembic::AbcGeom::IPolyMeshSchema::Sample &sample =
+        keys.floorSample(sampleIndex);
 
     // take care of the topology
     if (sampleIndex == 0) {
@@ -380,9 +360,13 @@ AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
       // check if we have UVs in the alembic file
       Alembic::AbcGeom::IV2fGeomParam uvParam =
           typedObject.getSchema().getUVsParam();
-      if (uvParam.valid())
+      if (uvParam.valid()) {
         setUVParams(typedObject, sampleInfo, shapeNode, ind.indices,
                     ind.faceIndices, uvParam);
+        ud->stats.faceVaryingIn += ind.faceIndices->nelements;
+        ud->stats.faceVaryingOut +=
+            AiNodeGetArray(shapeNode, "uvlist")->nelements;
+      }
 
       // check if we have a bindpose in the alembic file
       if (typedObject.getSchema().getPropertyHeader(".bindpose") != NULL) {
@@ -412,7 +396,8 @@ AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
     // access the positions
     Alembic::Abc::N3fArraySamplePtr abcNor = NULL;
     if(haveNormals)
-      abcNor = normalParam.getExpandedValue(sampleInfo.floorIndex).getVals();
+      abcNor = getNormalsOfSample(normalParam, sampleInfo.floorIndex,
+                                  normalsCache);
 
 
     if (pos == NULL) {
@@ -422,31 +407,45 @@ AtNode *createPolyMeshNode(nodeData &nodata, userData *ud,
     }
 
     const bool interpolated = hadToInterpolatePositions(
-      sampleIndex, typedObject.getSchema(), sample, pos, posOffset, samples, sampleInfo, ud->gCurrTime, dynamicTopology);
+      sampleIndex, typedObject.getSchema(), keys, pos, posOffset, samples, dynamicTopology);
 
 
     if (abcNor != NULL) {
       if (nor == NULL)
         nor = AiArrayAllocate((AtInt)abcNor->size(), (AtInt)minNumSamples, AI_TYPE_VECTOR);
 
+      const AtULong prevNorOffset = norOffset;
       if (!interpolated || dynamicTopology)
         removeNormalsDuplicate(nor, norOffset, abcNor, sampleInfo, nsIdx,
                                ind.faceIndices);
       else {
         Alembic::Abc::N3fArraySamplePtr abcNor2 =
-            normalParam.getExpandedValue(sampleInfo.ceilIndex).getVals();
+            getNormalsOfSample(normalParam, sampleInfo.ceilIndex, normalsCache);
 
         removeNormalsDuplicateDynTopology(nor, norOffset, abcNor, abcNor2,
                                           (float)sampleInfo.alpha, sampleInfo,
                                           nsIdx, ind.faceIndices);
       }
+      ud->stats.faceVaryingIn += ind.faceIndices->nelements;
+      ud->stats.faceVaryingOut += norOffset - prevNorOffset;
     }
-    else if(haveNormals == false)
-    {
-      nor = AiArrayAllocate((AtInt)pos->nelements, (AtInt)minNumSamples, AI_TYPE_VECTOR);
+  }
 
-      point_normal(ind, abcFaceCounts, abcFaceIndices, pos, nor, nsIdx);
+  // generate smooth normals for every motion key from the final positions
+  if (!haveNormals && pos != NULL) {
+    vertexNormalsGenerator generator(abcFaceCounts, abcFaceIndices,
+                                     pos->nelements);
+    nor = AiArrayAllocate(pos->nelements, (AtInt)minNumSamples,
+                          AI_TYPE_VECTOR);
+    for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
+      const size_t keyOffset = sampleIndex * pos->nelements;
+      generator.compute((const float *)((AtPoint *)pos->data + keyOffset),
+                        (float *)((AtVector *)nor->data + keyOffset));
     }
+
+    // the normals are per vertex
+    memcpy(nsIdx->data, ind.faceIndices->data,
+           ind.faceIndices->nelements * sizeof(AtUInt32));
   }
 
   AiNodeSetArray(shapeNode, "vlist", pos);
@@ -489,14 +488,15 @@ AtNode *createSubDNode(nodeData &nodata, userData *ud,
   AtULong posOffset = 0;
   Alembic::Abc::Int32ArraySamplePtr abcFaceCounts;
 
+  motionKeyReader<Alembic::AbcGeom::ISubDSchema> keys(typedObject.getSchema(),
+                                                      samples, minNumSamples);
+  keys.addToStats(ud->stats);
   for (size_t sampleIndex = 0; sampleIndex < minNumSamples; ++sampleIndex) {
-    SampleInfo sampleInfo = getSampleInfo(
-        samples[sampleIndex], typedObject.getSchema().getTimeSampling(),
-        typedObject.getSchema().getNumSamples());
+    SampleInfo &sampleInfo = keys.info(sampleIndex);
 
     // get the floor sample
-    Alembic::AbcGeom::ISubDSchema::Sample sample;
-    typedObject.getSchema().get(sample, sampleInfo.floorIndex);
+    Alembic::AbcGeom::ISubDSchema::Sample &sample =
+        keys.floorSample(sampleIndex);
 
     // take care of the topology
     if (sampleIndex == 0) {
@@ -532,8 +532,8 @@ AtNode *createSubDNode(nodeData &nodata, userData *ud,
                             AI_TYPE_POINT);
       firstSampleCount = sample.getFaceIndices()->size();
     }
-    hadToInterpolatePositions(sampleIndex, typedObject.getSchema(), sample, pos, posOffset,
-                              samples, sampleInfo, ud->gCurrTime, dynamicTopology);
+    hadToInterpolatePositions(sampleIndex, typedObject.getSchema(), keys, pos,
+                              posOffset, samples, dynamicTopology);
   }
   AiNodeSetArray(shapeNode, "vlist", pos);
 
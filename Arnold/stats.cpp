@@ -0,0 +1,170 @@
+#include "stdafx.h"
+
+#include "stats.h"
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+static const char *gNodeTypeNames[expansionStats::NB_NODE_TYPES] = {
+    "instance", "polymesh", "subd", "curves", "nurbs", "points", "other"};
+
+static Alembic::Util::int64_t nowMicroseconds()
+{
+  static const boost::posix_time::ptime epoch(
+      boost::gregorian::date(1970, 1, 1));
+  return (boost::posix_time::microsec_clock::universal_time() - epoch)
+      .total_microseconds();
+}
+
+static std::string jsonEscape(const std::string &str)
+{
+  std::string result;
+  for (size_t i = 0; i < str.size(); ++i) {
+    const unsigned char c = (unsigned char)str[i];
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\r':
+        result += "\\r";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (c < 0x20) {
+          // the other control characters are not allowed raw in JSON
+          char escaped[8];
+          sprintf(escaped, "\\u%04x", (unsigned int)c);
+          result += escaped;
+        }
+        else {
+          result += (char)c;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+static double ratio(size_t part, size_t total)
+{
+  return total ? (double)part / (double)total : 0.0;
+}
+
+expansionStats::expansionStats()
+    : initSeconds(0.0),
+      nodesCreated(0),
+      geometryBytes(0),
+      samplesRequested(0),
+      samplesRead(0),
+      faceVaryingIn(0),
+      faceVaryingOut(0)
+{
+  for (int t = 0; t < NB_NODE_TYPES; ++t) {
+    getNodeSeconds[t] = 0.0;
+    getNodeCalls[t] = 0;
+  }
+}
+
+void expansionStats::addGeometry(AtNode *node, nodeType type)
+{
+  static const char *polyMeshParams[] = {"nsides", "vidxs",  "vlist", "nlist",
+                                         "nidxs",  "uvlist", "uvidxs", NULL};
+  static const char *curvesParams[] = {"num_points", "points", "radius", NULL};
+  static const char *pointsParams[] = {"points", "radius", NULL};
+
+  const char **params = NULL;
+  switch (type) {
+    case POLYMESH:
+    case SUBD:
+      params = polyMeshParams;
+      break;
+    case CURVES:
+      params = curvesParams;
+      break;
+    case POINTS:
+      params = pointsParams;
+      break;
+    default:
+      return;
+  }
+
+  for (; *params != NULL; ++params) {
+    AtArray *array = AiNodeGetArray(node, *params);
+    if (array != NULL) {
+      geometryBytes += (Alembic::Util::uint64_t)array->nelements *
+                       array->nkeys * AiParamGetTypeSize(array->type);
+    }
+  }
+}
+
+void expansionStats::report() const
+{
+  double getNodeTotal = 0.0;
+  size_t callsTotal = 0;
+  std::stringstream perType;
+  for (int t = 0; t < NB_NODE_TYPES; ++t) {
+    getNodeTotal += getNodeSeconds[t];
+    callsTotal += getNodeCalls[t];
+    if (getNodeCalls[t] > 0) {
+      perType << " " << gNodeTypeNames[t] << "=" << getNodeCalls[t] << "/"
+              << getNodeSeconds[t] << "s";
+    }
+  }
+
+  AiMsgInfo(
+      "[ExocortexAlembicArnold] Expansion of '%s' in '%s': init %.3fs, "
+      "getNode %.3fs over %u calls (%s ), %u nodes, %.2f MB of geometry, "
+      "%u/%u samples read, face-varying dedup %.1f%%",
+      identifier.c_str(), path.c_str(), initSeconds, getNodeTotal,
+      (unsigned int)callsTotal, perType.str().c_str(),
+      (unsigned int)nodesCreated, (double)geometryBytes / (1024.0 * 1024.0),
+      (unsigned int)samplesRead, (unsigned int)samplesRequested,
+      100.0 * (1.0 - ratio(faceVaryingOut, faceVaryingIn)));
+
+  if (jsonFile.empty()) {
+    return;
+  }
+
+  // one JSON object per line, so several procedurals can share the file
+  std::ofstream out(jsonFile.c_str(), std::ios::out | std::ios::app);
+  if (!out) {
+    AiMsgWarning("[ExocortexAlembicArnold] Cannot write the stats file '%s'.",
+                 jsonFile.c_str());
+    return;
+  }
+  out << "{\"path\": \"" << jsonEscape(path) << "\", \"identifier\": \""
+      << jsonEscape(identifier) << "\", \"initSeconds\": " << initSeconds
+      << ", \"getNode\": {";
+  for (int t = 0; t < NB_NODE_TYPES; ++t) {
+    out << (t ? ", " : "") << "\"" << gNodeTypeNames[t]
+        << "\": {\"calls\": " << getNodeCalls[t]
+        << ", \"seconds\": " << getNodeSeconds[t] << "}";
+  }
+  out << "}, \"nodesCreated\": " << nodesCreated
+      << ", \"geometryBytes\": " << geometryBytes
+      << ", \"samplesRequested\": " << samplesRequested
+      << ", \"samplesRead\": " << samplesRead
+      << ", \"sampleHitRatio\": "
+      << 1.0 - ratio(samplesRead, samplesRequested)
+      << ", \"faceVaryingIn\": " << faceVaryingIn
+      << ", \"faceVaryingOut\": " << faceVaryingOut
+      << ", \"dedupRatio\": " << 1.0 - ratio(faceVaryingOut, faceVaryingIn)
+      << "}" << std::endl;
+}
+
+expansionTimer::expansionTimer(double &seconds)
+    : mSeconds(&seconds), mStart(nowMicroseconds())
+{
+}
+
+expansionTimer::~expansionTimer()
+{
+  *mSeconds += (double)(nowMicroseconds() - mStart) * 1.0e-6;
+}
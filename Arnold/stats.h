@@ -0,0 +1,64 @@
+#ifndef _ARNOLD_ALEMBIC_STATS_H_
+#define _ARNOLD_ALEMBIC_STATS_H_
+
+#include "utility.h"
+
+/**
+ * What a procedural costs to expand: timings per object type, nodes and
+ * geometry created, samples read and how well the dedup and sample sharing
+ * worked. Reported once per procedural at Cleanup.
+ */
+struct expansionStats {
+  enum nodeType {
+    INSTANCE,
+    POLYMESH,
+    SUBD,
+    CURVES,
+    NURBS,
+    POINTS,
+    OTHER,
+    NB_NODE_TYPES
+  };
+
+  std::string path;
+  std::string identifier;
+  std::string jsonFile;  // aggregated output, if not empty
+
+  double initSeconds;
+  double getNodeSeconds[NB_NODE_TYPES];
+  size_t getNodeCalls[NB_NODE_TYPES];
+  size_t nodesCreated;
+  Alembic::Util::uint64_t geometryBytes;
+
+  // motion key samples asked for vs. actually read
+  size_t samplesRequested;
+  size_t samplesRead;
+
+  // face-varying values before and after the dedup
+  size_t faceVaryingIn;
+  size_t faceVaryingOut;
+
+  expansionStats();
+
+  // adds the size of the geometry arrays of a newly created node
+  void addGeometry(AtNode *node, nodeType type);
+
+  // one line summary through AiMsgInfo, and a JSON line in jsonFile
+  void report() const;
+};
+
+// accumulates the elapsed wall time into a counter when going out of scope
+class expansionTimer {
+ public:
+  expansionTimer(double &seconds);
+  ~expansionTimer();
+
+  // accumulate into another counter, for when the object type is found late
+  void retarget(double &seconds) { mSeconds = &seconds; }
+
+ private:
+  double *mSeconds;
+  Alembic::Util::int64_t mStart;
+};
+
+#endif
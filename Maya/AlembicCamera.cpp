@@ -117,6 +117,8 @@ MStatus AlembicCamera::Save(double time, unsigned int timeIndex,
 void AlembicCameraNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -376,8 +378,9 @@ MStatus AlembicCameraNode::compute(const MPlug& plug, MDataBlock& dataBlock)
     ESS_PROFILE_SCOPE("AlembicCameraNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
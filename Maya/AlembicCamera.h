@@ -2,6 +2,7 @@
 #define _ALEMBIC_CAMERA_H_
 
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 class AlembicCamera : public AlembicObject {
@@ -48,6 +49,8 @@ class AlembicCameraNode : public AlembicObjectNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::ICameraSchema mSchema;
 
   // output attributes
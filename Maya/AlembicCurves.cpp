@@ -3,6 +3,7 @@
 #include "AlembicCurves.h"
 #include "AttributesReading.h"
 #include "MetaData.h"
+#include "PointsInterpolation.h"
 
 #include <maya/MArrayDataBuilder.h>
 #include <maya/MArrayDataHandle.h>
@@ -107,6 +108,10 @@ void AlembicCurveAccumulator::StopRecordingFrame(void)
     first->second->stopRecording();
   }
 }
+bool AlembicCurveAccumulator::HasAccumulators(void)
+{
+  return !accumulators.empty();
+}
 void AlembicCurveAccumulator::Destroy(void) { accumulators.clear(); }
 AlembicCurveAccumulatorPtr AlembicCurveAccumulator::GetAccumulator(
     int id, const MObject &ref, SceneNodePtr eNode, AlembicWriteJob *in_Job,
@@ -281,6 +286,8 @@ MStatus AlembicCurves::Save(double time, unsigned int timeIndex,
 void AlembicCurvesNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -410,8 +417,9 @@ MStatus AlembicCurvesNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     ESS_PROFILE_SCOPE("AlembicCurvesNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -450,8 +458,9 @@ MStatus AlembicCurvesNode::compute(const MPlug &plug, MDataBlock &dataBlock)
   Abc::P3fArraySamplePtr samplePos = sample.getPositions();
   Abc::P3fArraySamplePtr samplePos2 = sample2.getPositions();
   Abc::Int32ArraySamplePtr nbVertices = sample.getCurvesNumVertices();
-  const bool applyBlending =
-      (blend == 0.0f) ? false : (samplePos->size() == samplePos2->size());
+  const PointsInterpolator interpolator(samplePos, samplePos2,
+                                        Abc::V3fArraySamplePtr(),
+                                        Abc::V3fArraySamplePtr(), blend);
 
   Abc::FloatArraySamplePtr pKnotVec = getKnotVector(mObj);
   Abc::UInt16ArraySamplePtr pOrders = getCurveOrders(mObj);
@@ -464,6 +473,11 @@ MStatus AlembicCurvesNode::compute(const MPlug &plug, MDataBlock &dataBlock)
 
   const int degree = (sample.getType() == AbcG::kCubic) ? 3 : 1;
   const bool closed = (sample.getWrap() == AbcG::kPeriodic);
+
+  // the points of all the curves are interpolated at once
+  MPointArray allPoints;
+  interpolator.compute(allPoints);
+
   unsigned int pointOffset = 0;
   unsigned int knotOffset = 0;
   for (int ii = 0; ii < nbVertices->size(); ++ii) {
@@ -491,31 +505,9 @@ MStatus AlembicCurvesNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     }
 
     MPointArray points;
-    if (samplePos->size() > 0) {
-      points.setLength((unsigned int)nbCVs);
-      if (applyBlending) {
-        for (unsigned int i = 0; i < nbCVs; ++i) {
-          const Abc::P3fArraySample::value_type &vals1 =
-              samplePos->get()[pointOffset + i];
-          const Abc::P3fArraySample::value_type &vals2 =
-              samplePos2->get()[pointOffset + i];
-          MPoint &pt = points[i];
-
-          pt.x = vals1.x + (vals2.x - vals1.x) * blend;
-          pt.y = vals1.y + (vals2.y - vals1.y) * blend;
-          pt.z = vals1.z + (vals2.z - vals1.z) * blend;
-        }
-      }
-      else {
-        for (unsigned int i = 0; i < nbCVs; ++i) {
-          const Abc::P3fArraySample::value_type &vals =
-              samplePos->get()[pointOffset + i];
-          MPoint &pt = points[i];
-          pt.x = vals.x;
-          pt.y = vals.y;
-          pt.z = vals.z;
-        }
-      }
+    if (pointOffset < allPoints.length()) {
+      points = MPointArray(&allPoints[pointOffset],
+                           std::min(nbCVs, allPoints.length() - pointOffset));
       pointOffset += nbCVs;
     }
 
@@ -570,6 +562,8 @@ MStatus AlembicCurvesNode::setDependentsDirty(const MPlug &plugBeingDirtied,
 void AlembicCurvesDeformNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -692,8 +686,9 @@ MStatus AlembicCurvesDeformNode::deform(MDataBlock &dataBlock,
     ESS_PROFILE_SCOPE("AlembicCurvesDeformNode::deform readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -733,48 +728,15 @@ MStatus AlembicCurvesDeformNode::deform(MDataBlock &dataBlock,
     samplePos2 = sample2.getPositions();
   }
 
+  MPointArray abcPositions;
+  PointsInterpolator(samplePos, samplePos2, Abc::V3fArraySamplePtr(),
+                     Abc::V3fArraySamplePtr(), (float)sampleInfo.alpha)
+      .compute(abcPositions);
+
   // iteration should not be necessary. the iteration is only
   // required if the same mesh is attached to the same deformer
   // several times
-  float blend = (float)sampleInfo.alpha;
-  float iblend = 1.0f - blend;
-  unsigned int index = 0;
-  for (iter.reset(); !iter.isDone(); iter.next()) {
-    index = iter.index();
-    // MFloatPoint pt = iter.position();
-    MPoint pt = iter.position();
-    MPoint abcPos = pt;
-    float weight = weightValue(dataBlock, geomIndex, index) * env;
-    if (weight == 0.0f) {
-      continue;
-    }
-    float iweight = 1.0f - weight;
-    if (index >= samplePos->size()) {
-      continue;
-    }
-    bool done = false;
-    if (sampleInfo.alpha != 0.0) {
-      if (samplePos2->size() == samplePos->size()) {
-        abcPos.x = iweight * pt.x +
-                   weight * (samplePos->get()[index].x * iblend +
-                             samplePos2->get()[index].x * blend);
-        abcPos.y = iweight * pt.y +
-                   weight * (samplePos->get()[index].y * iblend +
-                             samplePos2->get()[index].y * blend);
-        abcPos.z = iweight * pt.z +
-                   weight * (samplePos->get()[index].z * iblend +
-                             samplePos2->get()[index].z * blend);
-        done = true;
-      }
-    }
-    if (!done) {
-      abcPos.x = iweight * pt.x + weight * samplePos->get()[index].x;
-      abcPos.y = iweight * pt.y + weight * samplePos->get()[index].y;
-      abcPos.z = iweight * pt.z + weight * samplePos->get()[index].z;
-    }
-    iter.setPosition(abcPos);
-  }
-  return MStatus::kSuccess;
+  return blendPositions(dataBlock, iter, geomIndex, env, abcPositions);
 }
 
 // Cache the plug arrays for use in setDependentsDirty
@@ -958,40 +920,15 @@ MStatus AlembicCurvesLocatorNode::compute(const MPlug &plug,
       }
     }
 
-    if (mPositions.size() != samplePos->size()) {
-      mPositions.resize(samplePos->size());
-    }
-
-    // check if we need to interpolate
-    bool done = false;
+    // interpolate if needed
+    PointsInterpolator(samplePos, sample2.getPositions(),
+                       Abc::V3fArraySamplePtr(), Abc::V3fArraySamplePtr(),
+                       (float)sampleInfo.alpha)
+        .compute(mPositions);
     mBoundingBox.clear();
-    if (sampleInfo.alpha != 0.0) {
-      Abc::P3fArraySamplePtr samplePos2 = sample2.getPositions();
-      if (samplePos->size() == samplePos2->size()) {
-        float alpha = float(sampleInfo.alpha);
-        float ialpha = 1.0f - alpha;
-        for (unsigned int i = 0; i < samplePos->size(); i++) {
-          mPositions[i].x =
-              ialpha * samplePos->get()[i].x + alpha * samplePos2->get()[i].x;
-          mPositions[i].y =
-              ialpha * samplePos->get()[i].y + alpha * samplePos2->get()[i].y;
-          mPositions[i].z =
-              ialpha * samplePos->get()[i].z + alpha * samplePos2->get()[i].z;
-          mBoundingBox.expand(
-              MPoint(mPositions[i].x, mPositions[i].y, mPositions[i].z));
-        }
-        done = true;
-      }
-    }
-
-    if (!done) {
-      for (unsigned int i = 0; i < samplePos->size(); i++) {
-        mPositions[i].x = samplePos->get()[i].x;
-        mPositions[i].y = samplePos->get()[i].y;
-        mPositions[i].z = samplePos->get()[i].z;
-        mBoundingBox.expand(
-            MPoint(mPositions[i].x, mPositions[i].y, mPositions[i].z));
-      }
+    for (size_t i = 0; i < mPositions.size(); i++) {
+      mBoundingBox.expand(
+          MPoint(mPositions[i].x, mPositions[i].y, mPositions[i].z));
     }
 
     // get the colors
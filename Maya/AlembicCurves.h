@@ -4,6 +4,7 @@
 #include <maya/MFnNurbsCurve.h>
 #include <maya/MUint64Array.h>
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 //-----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
@@ -56,6 +57,7 @@ class AlembicCurveAccumulator {
   static void Initialize(void);
   static void StartRecordingFrame(void);
   static void StopRecordingFrame(void);
+  static bool HasAccumulators(void);
   static void Destroy(void);
   static AlembicCurveAccumulatorPtr GetAccumulator(int id, const MObject &ref,
                                                    SceneNodePtr eNode,
@@ -124,6 +126,8 @@ class AlembicCurvesNode : public AlembicObjectNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::ICurves mObj;
   AbcG::ICurvesSchema mSchema;
 
@@ -164,6 +168,8 @@ class AlembicCurvesDeformNode : public AlembicObjectDeformNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::ICurvesSchema mSchema;
 
   // output attributes
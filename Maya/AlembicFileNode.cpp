@@ -1,12 +1,13 @@
 #include "stdafx.h"
 
 #include "AlembicFileNode.h"
-#include <cstdio>
-#include <fstream>
-#include <sstream>
+#include <boost/bind.hpp>
+#include <cctype>
+#include <cstdlib>
 
 MObject AlembicFileNode::mTimeAttr;
 MObject AlembicFileNode::mMultiFileAttr;
+MObject AlembicFileNode::mPrefetchAttr;
 
 MObject AlembicFileNode::mFileNameAttr;
 MObject AlembicFileNode::mOutFileNameAttr;
@@ -33,6 +34,15 @@ MStatus AlembicFileNode::initialize()
   status = nAttr.setKeyable(false);
   status = addAttribute(mMultiFileAttr);
 
+  mPrefetchAttr = nAttr.create("prefetchFiles", "pff", MFnNumericData::kInt, 3);
+#ifndef MAYA_2011_UNSUPPORTED
+  nAttr.setNiceNameOverride("Files to Prefetch");
+#endif
+  status = nAttr.setStorable(true);
+  status = nAttr.setMin(0);
+  status = nAttr.setKeyable(false);
+  status = addAttribute(mPrefetchAttr);
+
   mTimeAttr = uAttr.create("inTime", "tm", MFnUnitAttribute::kTime, 0.0);
   status = uAttr.setStorable(true);
   status = uAttr.setKeyable(true);
@@ -61,19 +71,212 @@ MStatus AlembicFileNode::initialize()
   return status;
 }
 
-static std::string createFileTemplate(const std::string &filename, size_t num,
-                                      size_t dot, bool usePadding)
+void AlembicFilePrefetcher::deleteEntry(Entry *entry)
+{
+  if (entry->archive != NULL) {
+    entry->archive->reset();
+    delete entry->archive;
+  }
+  delete entry;
+}
+
+void AlembicFilePrefetcher::run()
+{
+  for (;;) {
+    std::string path;
+    {
+      boost::mutex::scoped_lock lock(mMutex);
+      while (!mStop && mPending.empty()) {
+        mCondition.wait(lock);
+      }
+      if (mStop) {
+        return;
+      }
+      path = mPending.front();
+      mPending.pop_front();
+      if (mReady.find(path) != mReady.end()) {
+        continue;
+      }
+    }
+
+    // only Ogawa archives are opened here, HDF5 reads can't run beside the
+    // reads of the main thread. This thread must not log either, as that
+    // goes through Maya.
+    Entry *entry = new Entry;
+    entry->archive = NULL;
+    try {
+      entry->archive =
+          new Abc::IArchive(Alembic::AbcCoreOgawa::ReadArchive(), path);
+      Abc::IObject top = entry->archive->getTop();
+      if (!entry->archive->valid() ||
+          addObjectToCache(&entry->archiveCache, top, "", NULL) == NULL) {
+        deleteEntry(entry);
+        entry = NULL;
+      }
+    }
+    catch (std::exception &) {
+      deleteEntry(entry);
+      entry = NULL;
+    }
+    if (entry == NULL) {
+      continue;
+    }
+
+    boost::mutex::scoped_lock lock(mMutex);
+    if (mStop || mReady.find(path) != mReady.end()) {
+      deleteEntry(entry);
+    }
+    else {
+      mReady[path] = entry;
+    }
+  }
+}
+
+void AlembicFilePrefetcher::request(const std::vector<std::string> &paths)
+{
+  std::vector<Entry *> unused;
+  {
+    boost::mutex::scoped_lock lock(mMutex);
+    mPending.assign(paths.begin(), paths.end());
+    for (EntryMap::iterator it = mReady.begin(); it != mReady.end();) {
+      if (std::find(paths.begin(), paths.end(), it->first) == paths.end()) {
+        unused.push_back(it->second);
+        mReady.erase(it++);
+      }
+      else {
+        ++it;
+      }
+    }
+    if (mThread.get_id() == boost::thread::id()) {
+      mStop = false;
+      mThread = boost::thread(boost::bind(&AlembicFilePrefetcher::run, this));
+    }
+  }
+  mCondition.notify_one();
+
+  for (size_t i = 0; i < unused.size(); ++i) {
+    deleteEntry(unused[i]);
+  }
+}
+
+bool AlembicFilePrefetcher::adopt(const std::string &path)
 {
-  std::stringstream ss;
-  ss << filename.substr(0, num) << "%";
-  if (usePadding) {
-    const size_t diff = dot - num;
-    if (diff) {
-      ss << "0" << diff;
+  Entry *entry = NULL;
+  {
+    boost::mutex::scoped_lock lock(mMutex);
+    EntryMap::iterator it = mReady.find(path);
+    if (it == mReady.end()) {
+      return false;
     }
+    entry = it->second;
+    mReady.erase(it);
+  }
+
+  if (archiveExists(path)) {
+    deleteEntry(entry);
   }
-  ss << "d" << filename.substr(dot);
-  return ss.str();
+  else {
+    addArchive(entry->archive, entry->archiveCache);
+    delete entry;
+  }
+  return true;
+}
+
+void AlembicFilePrefetcher::clear()
+{
+  {
+    boost::mutex::scoped_lock lock(mMutex);
+    mStop = true;
+    mPending.clear();
+  }
+  mCondition.notify_one();
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+  mThread = boost::thread();
+
+  for (EntryMap::iterator it = mReady.begin(); it != mReady.end(); ++it) {
+    deleteEntry(it->second);
+  }
+  mReady.clear();
+}
+
+void AlembicFileNode::PreDestruction()
+{
+  mPrefetcher.clear();
+  if (mHeldFileName.length() > 0) {
+    delRefArchive(mHeldFileName);
+    mHeldFileName.clear();
+  }
+}
+
+// the sequence <prefix><frame><suffix> of the file, <frame> being the digits
+// before the extension, with or without padding
+void AlembicFileNode::scanSequence()
+{
+  boost::system::error_code error;
+  const std::time_t dirTime = fs::last_write_time(mSequenceDir, error);
+  if (error || dirTime == mSequenceTime) {
+    return;
+  }
+  ESS_PROFILE_SCOPE("AlembicFileNode::scanSequence");
+  mSequenceTime = dirTime;
+  mSequenceFiles.clear();
+
+  const size_t prefixLength = mSequencePrefix.size();
+  const size_t suffixLength = mSequenceSuffix.size();
+  for (fs::directory_iterator it(mSequenceDir, error), end;
+       !error && it != end; it.increment(error)) {
+    const std::string name = it->path().filename().string();
+    if (name.size() <= prefixLength + suffixLength ||
+        name.compare(0, prefixLength, mSequencePrefix) != 0 ||
+        name.compare(name.size() - suffixLength, suffixLength,
+                     mSequenceSuffix) != 0) {
+      continue;
+    }
+    const std::string digits =
+        name.substr(prefixLength, name.size() - prefixLength - suffixLength);
+    size_t first = (digits[0] == '-') ? 1 : 0;
+    if (first == digits.size() ||
+        digits.find_first_not_of("0123456789", first) != std::string::npos) {
+      continue;
+    }
+
+    // the padded file wins when both exist for a frame
+    const int frame = atoi(digits.c_str());
+    std::map<int, std::string>::iterator found = mSequenceFiles.find(frame);
+    if (found != mSequenceFiles.end() && digits.size() != mSequencePadding) {
+      continue;
+    }
+    mSequenceFiles[frame] = mSequenceDir + "/" + name;
+  }
+}
+
+// requests the archives of the next files in the playback direction
+void AlembicFileNode::prefetch(int curFrame, int nbFiles)
+{
+  std::vector<std::string> paths;
+  std::map<int, std::string>::const_iterator it =
+      mSequenceFiles.find(curFrame);
+  for (int i = 0; i < nbFiles && it != mSequenceFiles.end(); ++i) {
+    if (mDirection > 0) {
+      ++it;
+    }
+    else if (it == mSequenceFiles.begin()) {
+      break;
+    }
+    else {
+      --it;
+    }
+    if (it == mSequenceFiles.end()) {
+      break;
+    }
+    const std::string path = resolvePath(it->second);
+    if (!archiveExists(path)) {
+      paths.push_back(path);
+    }
+  }
+  mPrefetcher.request(paths);
 }
 
 MStatus AlembicFileNode::compute(const MPlug &plug, MDataBlock &dataBlock)
@@ -83,57 +286,71 @@ MStatus AlembicFileNode::compute(const MPlug &plug, MDataBlock &dataBlock)
 
   if (lastFileName != inFileName) {
     lastFileName = inFileName;
-    multiFileTemplate.clear();
-    multiFileTemplateNoPadding.clear();
+    mSequenceDir.clear();
+    mSequenceFiles.clear();
+    mSequenceTime = 0;
     lastMultiFileName = inFileName;
+    lastCurFrame = -50000;
   }
 
   if (dataBlock.inputValue(mMultiFileAttr).asBool()) {
-    if (multiFileTemplate.size() == 0) {
-      const std::string filename = inFileName.asChar();
-      size_t dot = filename.rfind(".");
-      size_t num = dot - 1;
-      if (dot != std::string::npos) {
-        while (filename[num] >= '0' && filename[num] <= '9') {
+    if (mSequenceDir.empty()) {
+      const std::string filename =
+          resolvePath(std::string(inFileName.asChar()));
+      const size_t slash = filename.rfind('/');
+      const size_t dot = filename.rfind('.');
+      if (dot != std::string::npos &&
+          (slash == std::string::npos || dot > slash)) {
+        size_t num = dot;
+        while (num > 0 && isdigit(filename[num - 1])) {
           --num;
         }
-        ++num;
-      }
 
-      // The Padding format <filename>#####.abc --> <filename>00010.abc,
-      // <filename>08921.abc
-      multiFileTemplate = createFileTemplate(filename, num, dot, true);
-
-      // The Non-Padding format <filename>#.abc --> <filename>10.abc,
-      // <filename>8921.abc
-      multiFileTemplateNoPadding =
-          createFileTemplate(filename, num, dot, false);
+        // <filename>#####.abc --> <filename>00010.abc, <filename>08921.abc
+        // and <filename>#.abc --> <filename>10.abc, <filename>8921.abc
+        const size_t start = (slash == std::string::npos) ? 0 : slash + 1;
+        mSequenceDir =
+            (slash == std::string::npos) ? "." : filename.substr(0, slash);
+        mSequencePrefix = filename.substr(start, num - start);
+        mSequenceSuffix = filename.substr(dot);
+        mSequencePadding = dot - num;
+        scanSequence();
+      }
     }
 
     const int curFrame = dataBlock.inputValue(mTimeAttr).asTime().value();
-    if (lastCurFrame != curFrame) {
-      std::vector<char> vecFormattedName(inFileName.length() + 30, '\0');
-      char *tmpFormattedName = &(vecFormattedName[0]);
-
-      sprintf(tmpFormattedName, multiFileTemplate.c_str(), curFrame);
-      std::ifstream in(tmpFormattedName);
-      if (in.is_open()) {  // try the padded version
-        in.close();
-        lastMultiFileName = tmpFormattedName;
+    if (lastCurFrame != curFrame && !mSequenceDir.empty()) {
+      // rescanned only if files were added or removed
+      scanSequence();
+
+      std::map<int, std::string>::const_iterator it =
+          mSequenceFiles.find(curFrame);
+      if (it != mSequenceFiles.end()) {
+        if (lastCurFrame != -50000) {
+          mDirection = (curFrame < lastCurFrame) ? -1 : 1;
+        }
+        lastMultiFileName = it->second.c_str();
         lastCurFrame = curFrame;
-      }
-      else {
-        sprintf(tmpFormattedName, multiFileTemplateNoPadding.c_str(), curFrame);
-        in.open(tmpFormattedName);
-        if (in.is_open()) {  // try the non-padded version!
-          in.close();
-          lastMultiFileName = tmpFormattedName;
-          lastCurFrame = curFrame;
+
+        // keep the archive of the current frame open, the downstream nodes
+        // open it next
+        const MString path = resolvePath(lastMultiFileName);
+        mPrefetcher.adopt(path.asChar());
+        if (path != mHeldFileName && addRefArchive(path) >= 0) {
+          if (mHeldFileName.length() > 0) {
+            delRefArchive(mHeldFileName);
+          }
+          mHeldFileName = path;
         }
+
+        prefetch(curFrame, dataBlock.inputValue(mPrefetchAttr).asInt());
       }
     }
     inFileName = lastMultiFileName;
   }
+  else if (mHeldFileName.length() > 0) {
+    PreDestruction();
+  }
 
   dataBlock.outputValue(mOutFileNameAttr).set(resolvePath(inFileName));
   dataBlock.outputValue(mOutFileNameAttr).setClean();
@@ -1,32 +1,90 @@
 #ifndef _ALEMBIC_FILENODE_H_
 #define _ALEMBIC_FILENODE_H_
 
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
 #include "AlembicObject.h"
 
+// Opens archives and builds their object cache in a background thread, so
+// the next files of a sequence are ready when playback reaches them.
+class AlembicFilePrefetcher {
+ public:
+  AlembicFilePrefetcher() : mStop(false) {}
+  ~AlembicFilePrefetcher() { clear(); }
+
+  // replaces the pending requests by paths, the prefetched archives which
+  // are not in paths anymore are closed
+  void request(const std::vector<std::string>& paths);
+
+  // hands a prefetched archive over to the shared archives, returns false if
+  // it is not ready
+  bool adopt(const std::string& path);
+
+  // stops the thread and closes all the prefetched archives
+  void clear();
+
+ private:
+  struct Entry {
+    Abc::IArchive* archive;
+    AbcArchiveCache archiveCache;
+  };
+  typedef std::map<std::string, Entry*> EntryMap;
+
+  void run();
+  static void deleteEntry(Entry* entry);
+
+  boost::thread mThread;
+  boost::mutex mMutex;
+  boost::condition_variable mCondition;
+  std::deque<std::string> mPending;
+  EntryMap mReady;
+  bool mStop;
+};
+
 class AlembicFileNode : public AlembicObjectNode {
  public:
-  AlembicFileNode() : lastCurFrame(-50000) {}
-  virtual ~AlembicFileNode() {}
+  AlembicFileNode()
+      : lastCurFrame(-50000),
+        mSequencePadding(0),
+        mSequenceTime(0),
+        mDirection(1)
+  {
+  }
+  virtual ~AlembicFileNode() { PreDestruction(); }
   // override virtual methods from MPxNode
-  virtual void PreDestruction(){};
+  virtual void PreDestruction();
   virtual MStatus compute(const MPlug& plug, MDataBlock& dataBlock);
   static void* creator() { return (new AlembicFileNode()); }
   static MStatus initialize();
 
  private:
+  void scanSequence();
+  void prefetch(int curFrame, int nbFiles);
+
   MString lastFileName;
-  std::string multiFileTemplate;
-  std::string multiFileTemplateNoPadding;
   int lastCurFrame;
   MString lastMultiFileName;
 
+  // frame to file index of the sequence, rescanned when its directory changes
+  std::string mSequenceDir;
+  std::string mSequencePrefix;
+  std::string mSequenceSuffix;
+  size_t mSequencePadding;
+  std::time_t mSequenceTime;
+  std::map<int, std::string> mSequenceFiles;
+
+  int mDirection;          // 1 when playing forward, -1 backward
+  MString mHeldFileName;   // the archive kept open by this node
+  AlembicFilePrefetcher mPrefetcher;
+
   // input attributes
   static MObject mTimeAttr;
   static MObject mMultiFileAttr;
+  static MObject mPrefetchAttr;
 
   // output attributes
   static MObject mFileNameAttr;
   static MObject mOutFileNameAttr;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -19,53 +19,97 @@
 #include "sceneGraph.h"
 
 /// Maya Progress Bar
+static const std::chrono::milliseconds gProgressUpdateInterval(100);
+
+MayaProgressBar::MayaProgressBar()
+    : mRange(1), mProgress(0), mCancelled(false), mStarted(false), mShown(false)
+{
+}
+
 void MayaProgressBar::init(int _min, int _max, int incr)
 {
   ESS_PROFILE_SCOPE("MayaProgressBar::init");
-  MString cmd = "ExoAlembic._functions.progressBar_init(";
-  cmd += ((_max -= _min) < 1) ? 1 : _max;
-  cmd += ")";
-
-  MGlobal::executePythonCommand(cmd);
+  mRange = ((_max -= _min) < 1) ? 1 : _max;
+  mProgress = 0;
+  if (mShown) {
+    MProgressWindow::setProgressRange(0, mRange);
+    MProgressWindow::setProgress(0);
+  }
 }
 
 void MayaProgressBar::start(void)
 {
   ESS_PROFILE_SCOPE("MayaProgressBar::start");
-  MGlobal::executePythonCommand("ExoAlembic._functions.progressBar_start()");
+  if (mStarted) {
+    return;
+  }
+  mStarted = true;
+  mCancelled = false;
+  mThreadId = boost::this_thread::get_id();
+  mLastUpdate = std::chrono::steady_clock::now();
+
+  if (MGlobal::mayaState() != MGlobal::kInteractive ||
+      !MProgressWindow::reserve()) {
+    return;
+  }
+  mShown = true;
+  MProgressWindow::setTitle("Alembic");
+  MProgressWindow::setInterruptable(true);
+  MProgressWindow::setProgressRange(0, mRange);
+  MProgressWindow::setProgress(0);
+  MProgressWindow::startProgress();
 }
 
 void MayaProgressBar::stop(void)
 {
   ESS_PROFILE_SCOPE("MayaProgressBar::stop");
-  MGlobal::executePythonCommand("ExoAlembic._functions.progressBar_stop()");
+  if (!mStarted) {
+    return;
+  }
+  mStarted = false;
+  if (mShown) {
+    MProgressWindow::endProgress();
+    mShown = false;
+  }
 }
 
-void MayaProgressBar::incr(int step)
+// only the thread which started the bar talks to Maya
+void MayaProgressBar::update()
 {
-  ESS_PROFILE_SCOPE("MayaProgressBar::incr");
-  switch (step) {
-    case 0:
-      break;
-    case 20:
-      MGlobal::executePythonCommand("ExoAlembic._functions.progressBar_incr()");
-      break;
-    default: {
-      MString cmd = "ExoAlembic._functions.progressBar_incr(";
-      cmd += step;
-      cmd += ")";
-      MGlobal::executePythonCommand(cmd);
-    } break;
+  if (!mShown || boost::this_thread::get_id() != mThreadId) {
+    return;
+  }
+  const std::chrono::steady_clock::time_point now =
+      std::chrono::steady_clock::now();
+  if (now - mLastUpdate < gProgressUpdateInterval) {
+    return;
+  }
+  mLastUpdate = now;
+
+  ESS_PROFILE_SCOPE("MayaProgressBar::update");
+  MProgressWindow::setProgress(std::min((int)mProgress, mRange));
+  if (MProgressWindow::isCancelled()) {
+    mCancelled = true;
   }
 }
 
+void MayaProgressBar::incr(int step)
+{
+  mProgress += step;
+  update();
+}
+
 bool MayaProgressBar::isCancelled(void)
 {
-  ESS_PROFILE_SCOPE("MayaProgressBar::isCancelled");
-  int result;
-  MGlobal::executePythonCommand(
-      "ExoAlembic._functions.progressBar_isCancelled()", result);
-  return result > 0;
+  update();
+  return mCancelled;
+}
+
+void MayaProgressBar::setCaption(std::string& caption)
+{
+  if (mShown && boost::this_thread::get_id() == mThreadId) {
+    MProgressWindow::setProgressStatus(caption.c_str());
+  }
 }
 
 /// Import command
@@ -83,6 +127,37 @@ MSyntax AlembicImportCommand::createSyntax(void)
 }
 
 void* AlembicImportCommand::creator(void) { return new AlembicImportCommand(); }
+// The import is not undoable, so the commands used to build the scene are not
+// recorded in the undo queue, and the viewports are not refreshed until the
+// scene is complete.
+class SceneBuildGuard {
+ public:
+  SceneBuildGuard() : mUndoState(0), mRefreshSuspended(false)
+  {
+    MGlobal::executeCommand("undoInfo -q -state", mUndoState);
+    if (mUndoState) {
+      MGlobal::executeCommand("undoInfo -stateWithoutFlush off");
+    }
+    if (MGlobal::mayaState() == MGlobal::kInteractive) {
+      mRefreshSuspended =
+          MGlobal::executeCommand("refresh -suspend on") == MS::kSuccess;
+    }
+  }
+  ~SceneBuildGuard()
+  {
+    if (mRefreshSuspended) {
+      MGlobal::executeCommand("refresh -suspend off");
+    }
+    if (mUndoState) {
+      MGlobal::executeCommand("undoInfo -stateWithoutFlush on");
+    }
+  }
+
+ private:
+  int mUndoState;
+  bool mRefreshSuspended;
+};
+
 MStatus AlembicImportCommand::importSingleJob(const MString& job, int jobNumber)
 {
   ESS_PROFILE_SCOPE("AlembicImportCommand::importSingleJob");
@@ -159,6 +234,7 @@ MStatus AlembicImportCommand::importSingleJob(const MString& job, int jobNumber)
   pBar.stop();
   pBar.init(0, nNumNodes, 1);
 
+  SceneBuildGuard buildGuard;
   if (jobParser.attachToExisting) {
     // pBar.setCaption(std::string("Attach"));
     MDagPath dagPath;
@@ -172,8 +248,10 @@ MStatus AlembicImportCommand::importSingleJob(const MString& job, int jobNumber)
   }
   else {
     // pBar.setCaption(std::string("Import"));
-    SceneNodeAppPtr appRoot(new SceneNodeMaya(fileTimeCtrl));
-    if (!ImportSceneFile(fileRoot, appRoot, jobParser, &pBar)) {
+    SceneNodeMaya* mayaRoot = new SceneNodeMaya(fileTimeCtrl);
+    SceneNodeAppPtr appRoot(mayaRoot);
+    if (!ImportSceneFile(fileRoot, appRoot, jobParser, &pBar) ||
+        !mayaRoot->createPendingNodes(jobParser)) {
       delRefArchive(jobParser.filename);
       return MS::kFailure;
     }
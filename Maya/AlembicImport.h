@@ -1,16 +1,36 @@
 #ifndef _ALEMBIC_IMPORT_H_
 #define _ALEMBIC_IMPORT_H_
 
+#include <atomic>
+#include <chrono>
 #include "AlembicObject.h"
 #include "CommonImport.h"
 
+// Progress in Maya's progress window. incr and isCancelled only touch
+// atomics and can be called from worker threads, the window itself is
+// refreshed from the thread which started the bar, at most 10 times a second.
 class MayaProgressBar : public CommonProgressBar {
  public:
+  MayaProgressBar();
+  ~MayaProgressBar() { stop(); }
+
   void init(int min, int max, int incr);
   void start(void);
   void stop(void);
   void incr(int step);
   bool isCancelled(void);
+  void setCaption(std::string& caption);
+
+ private:
+  void update();
+
+  int mRange;
+  std::atomic<int> mProgress;
+  std::atomic<bool> mCancelled;
+  bool mStarted;
+  bool mShown;  // false when the window is taken or in batch mode
+  boost::thread::id mThreadId;
+  std::chrono::steady_clock::time_point mLastUpdate;
 };
 
 class AlembicImportCommand : public MPxCommand {
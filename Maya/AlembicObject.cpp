@@ -2,6 +2,8 @@
 
 #include "AlembicObject.h"
 
+#include <maya/MArrayDataHandle.h>
+
 AlembicObject::AlembicObject(SceneNodePtr eNode, AlembicWriteJob* in_Job,
                              Abc::OObject oParent)
     : mExoSceneNode(eNode),
@@ -83,6 +85,76 @@ AlembicObjectDeformNode::~AlembicObjectDeformNode()
   gDeformNodes.erase(gDeformNodes.find(mRefId));
 }
 
+void AlembicObjectDeformNode::getWeights(MDataBlock& dataBlock,
+                                         unsigned int geomIndex, float env,
+                                         unsigned int count,
+                                         std::vector<float>& pointWeights)
+{
+  // the weights which are not set default to 1
+  pointWeights.assign(count, env);
+
+  MArrayDataHandle weightListHandle = dataBlock.inputArrayValue(weightList);
+  if (weightListHandle.jumpToElement(geomIndex) != MS::kSuccess) {
+    return;
+  }
+  MArrayDataHandle weightsHandle =
+      weightListHandle.inputValue().child(weights);
+  const unsigned int nbWeights = weightsHandle.elementCount();
+  for (unsigned int i = 0; i < nbWeights; ++i, weightsHandle.next()) {
+    const unsigned int index = weightsHandle.elementIndex();
+    if (index < count) {
+      pointWeights[index] = weightsHandle.inputValue().asFloat() * env;
+    }
+  }
+}
+
+MStatus AlembicObjectDeformNode::blendPositions(MDataBlock& dataBlock,
+                                                MItGeometry& iter,
+                                                unsigned int geomIndex,
+                                                float env,
+                                                const MPointArray& abcPositions)
+{
+  ESS_PROFILE_SCOPE("AlembicObjectDeformNode::blendPositions");
+  const unsigned int abcCount = abcPositions.length();
+
+  MPointArray points;
+  iter.allPositions(points);
+  const unsigned int count = points.length();
+  if (count != abcCount) {
+    // only some of the points are deformed, their indices are needed
+    for (iter.reset(); !iter.isDone(); iter.next()) {
+      const int index = iter.index();
+      if (index >= (int)abcCount) {
+        continue;
+      }
+      const float weight = weightValue(dataBlock, geomIndex, index) * env;
+      if (weight == 0.0f) {
+        continue;
+      }
+      const MPoint pt = iter.position();
+      iter.setPosition(pt + (abcPositions[index] - pt) * weight);
+    }
+    return MS::kSuccess;
+  }
+
+  std::vector<float> pointWeights;
+  getWeights(dataBlock, geomIndex, env, count, pointWeights);
+  if (count == 0) {
+    return MS::kSuccess;
+  }
+
+  MPoint* dst = &points[0];
+  const MPoint* src = &abcPositions[0];
+  const float* w = &pointWeights[0];
+  for (unsigned int i = 0; i < count; ++i) {
+    const double weight = w[i];
+    dst[i].x += (src[i].x - dst[i].x) * weight;
+    dst[i].y += (src[i].y - dst[i].y) * weight;
+    dst[i].z += (src[i].z - dst[i].z) * weight;
+  }
+  return iter.setAllPositions(points);
+}
+
 AlembicObjectEmitterNode::AlembicObjectEmitterNode()
 {
   mRefId = gRefIdMax;
@@ -3,11 +3,65 @@
 
 #include "CommonSceneGraph.h"
 
+#include <maya/MDoubleArray.h>
+
 class AlembicWriteJob;
 class AlembicObject;
 
 typedef std::shared_ptr<AlembicObject> AlembicObjectPtr;
 
+// The data of one sample of an object. The packet owns the arrays its
+// Alembic samples point to, so it can be stored in the archive by the writer
+// thread of the job after Save returned.
+class AlembicSamplePacket {
+ public:
+  virtual ~AlembicSamplePacket() {}
+
+  // turns the arrays gathered from Maya into the arrays of the sample, the
+  // packets of a frame are converted in parallel and must not call Maya
+  virtual void convert() {}
+  virtual void write() = 0;
+};
+typedef std::shared_ptr<AlembicSamplePacket> AlembicSamplePacketPtr;
+
+// copies of the Maya arrays for the packets, made by Save with a single get()
+// per array, the values of a point or vector follow each other
+inline void copyMayaArray(const MIntArray &src, std::vector<int> &dst)
+{
+  dst.resize(src.length());
+  if (!dst.empty()) {
+    src.get(&dst[0]);
+  }
+}
+inline void copyMayaArray(const MDoubleArray &src, std::vector<double> &dst)
+{
+  dst.resize(src.length());
+  if (!dst.empty()) {
+    src.get(&dst[0]);
+  }
+}
+inline void copyMayaArray(const MVectorArray &src, std::vector<double> &dst)
+{
+  dst.resize(src.length() * 3);
+  if (!dst.empty()) {
+    src.get((double(*)[3])&dst[0]);
+  }
+}
+inline void copyMayaArray(const MFloatVectorArray &src, std::vector<float> &dst)
+{
+  dst.resize(src.length() * 3);
+  if (!dst.empty()) {
+    src.get((float(*)[3])&dst[0]);
+  }
+}
+inline void copyMayaArray(const MFloatPointArray &src, std::vector<float> &dst)
+{
+  dst.resize(src.length() * 4);
+  if (!dst.empty()) {
+    src.get((float(*)[4])&dst[0]);
+  }
+}
+
 class AlembicObject {
  private:
   MObjectArray mRefs;
@@ -59,7 +113,19 @@ class AlembicObjectDeformNode : public MPxDeformerNode {
   virtual void PreDestruction() = 0;
 
  protected:
+  // blends the deformed points towards abcPositions by their weights times
+  // env. When the whole geometry is deformed, the points are read and
+  // written at once, otherwise they are blended one at a time.
+  MStatus blendPositions(MDataBlock& dataBlock, MItGeometry& iter,
+                         unsigned int geomIndex, float env,
+                         const MPointArray& abcPositions);
+
   unsigned int mRefId;
+
+ private:
+  // the deformer weights of the points [0, count) of geometry geomIndex
+  void getWeights(MDataBlock& dataBlock, unsigned int geomIndex, float env,
+                  unsigned int count, std::vector<float>& pointWeights);
 };
 
 class AlembicObjectEmitterNode : public MPxEmitterNode {
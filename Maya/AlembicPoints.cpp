@@ -3,6 +3,7 @@
 #include "AlembicPoints.h"
 #include "AttributesReading.h"
 #include "MetaData.h"
+#include "PointsInterpolation.h"
 
 #include <maya/MArrayDataBuilder.h>
 
@@ -91,6 +92,145 @@ bool AlembicPoints::sampleInstanceProperties(
   return true;
 }
 
+// the sample of a frame with the arrays it points to
+class AlembicPointsPacket : public AlembicSamplePacket {
+ public:
+  AlembicPointsPacket(const AbcG::OPointsSchema &schema,
+                      const Abc::OFloatArrayProperty &ageProperty,
+                      const Abc::OFloatArrayProperty &massProperty,
+                      const Abc::OC4fArrayProperty &colorProperty)
+      : hasColors(false),
+        globalCache(false),
+        mSchema(schema),
+        mAgeProperty(ageProperty),
+        mMassProperty(massProperty),
+        mColorProperty(colorProperty)
+  {
+  }
+
+  // the conversions which don't need Maya, run beside the other objects
+  virtual void convert()
+  {
+    ESS_PROFILE_SCOPE("AlembicPointsPacket::convert");
+    const size_t particleCount = positions.size() / 3;
+
+    // push the positions to the bbox
+    Abc::Box3d bbox;
+    posVec.resize(particleCount);
+    for (size_t i = 0; i < particleCount; i++) {
+      const double *out = &positions[i * 3];
+      Abc::V3f &in = posVec[i];
+      in.x = (float)out[0];
+      in.y = (float)out[1];
+      in.z = (float)out[2];
+      if (globalCache) {
+        globalXfo.multVecMatrix(in, in);
+      }
+      bbox.extendBy(in);
+    }
+    std::vector<double>().swap(positions);
+
+    velVec.resize(particleCount);
+    for (size_t i = 0; i < std::min(particleCount, velocities.size() / 3);
+         i++) {
+      const double *out = &velocities[i * 3];
+      Abc::V3f &in = velVec[i];
+      in.x = (float)out[0];
+      in.y = (float)out[1];
+      in.z = (float)out[2];
+      if (globalCache) {
+        globalXfo.multDirMatrix(in, in);
+      }
+    }
+    std::vector<double>().swap(velocities);
+
+    widthVec.resize(particleCount);
+    for (size_t i = 0; i < std::min(particleCount, radii.size()); i++) {
+      widthVec[i] = (float)radii[i];
+    }
+    std::vector<double>().swap(radii);
+
+    idVec.resize(particleCount);
+    for (size_t i = 0; i < std::min(particleCount, ids.size()); i++) {
+      idVec[i] = (Abc::uint64_t)ids[i];
+    }
+    std::vector<int>().swap(ids);
+
+    ageVec.resize(particleCount);
+    for (size_t i = 0; i < std::min(particleCount, ages.size()); i++) {
+      ageVec[i] = (float)ages[i];
+    }
+    std::vector<double>().swap(ages);
+
+    massVec.resize(particleCount);
+    for (size_t i = 0; i < std::min(particleCount, masses.size()); i++) {
+      massVec[i] = (float)masses[i];
+    }
+    std::vector<double>().swap(masses);
+
+    if (hasColors) {
+      colorVec.resize(particleCount);
+      const size_t nbColors = std::min(
+          particleCount, std::min(opacities.size(), rgbs.size() / 3));
+      for (size_t i = 0; i < nbColors; i++) {
+        const double *out = &rgbs[i * 3];
+        Imath::C4f &in = colorVec[i];
+        in.r = (float)out[0];
+        in.g = (float)out[1];
+        in.b = (float)out[2];
+        in.a = (float)opacities[i];
+      }
+      std::vector<double>().swap(rgbs);
+      std::vector<double>().swap(opacities);
+    }
+
+    // setup the sample
+    sample.setSelfBounds(bbox);
+    sample.setPositions(Abc::P3fArraySample(posVec));
+    sample.setVelocities(Abc::V3fArraySample(velVec));
+    sample.setWidths(AbcG::OFloatGeomParam::Sample(
+        Abc::FloatArraySample(widthVec), AbcG::kVertexScope));
+    sample.setIds(Abc::UInt64ArraySample(idVec));
+  }
+
+  virtual void write()
+  {
+    ESS_PROFILE_SCOPE("AlembicPointsPacket::write");
+    mAgeProperty.set(Abc::FloatArraySample(ageVec));
+    mMassProperty.set(Abc::FloatArraySample(massVec));
+    mColorProperty.set(Abc::C4fArraySample(colorVec));
+    mSchema.set(sample);
+  }
+
+  // copied from Maya by Save
+  std::vector<double> positions;
+  std::vector<double> velocities;
+  std::vector<double> radii;
+  std::vector<int> ids;
+  std::vector<double> ages;
+  std::vector<double> masses;
+  bool hasColors;
+  std::vector<double> rgbs;
+  std::vector<double> opacities;
+  bool globalCache;
+  Abc::M44f globalXfo;
+
+  AbcG::OPointsSchema::Sample sample;
+  std::vector<Abc::V3f> posVec;
+  std::vector<Abc::V3f> velVec;
+  std::vector<float> widthVec;
+  std::vector<Abc::uint64_t> idVec;
+  std::vector<float> ageVec;
+  std::vector<float> massVec;
+  std::vector<Abc::C4f> colorVec;
+
+ private:
+  AbcG::OPointsSchema mSchema;
+  Abc::OFloatArrayProperty mAgeProperty;
+  Abc::OFloatArrayProperty mMassProperty;
+  Abc::OC4fArrayProperty mColorProperty;
+};
+
 AlembicPoints::AlembicPoints(SceneNodePtr eNode, AlembicWriteJob *in_Job,
                              Abc::OObject oParent)
     : AlembicObject(eNode, in_Job, oParent), hasInstancer(false)
@@ -154,6 +294,12 @@ MStatus AlembicPoints::Save(double time, unsigned int timeIndex,
   // access the geometry
   MFnParticleSystem node(GetRef());
 
+  // the arrays of the sample belong to the packet, it is stored in the
+  // archive after the other objects of the frame are saved
+  AlembicPointsPacket *packet = new AlembicPointsPacket(
+      mSchema, mAgeProperty, mMassProperty, mColorProperty);
+  AlembicSamplePacketPtr packetPtr(packet);
+
   // save the metadata
   SaveMetaData(this);
 
@@ -174,19 +320,39 @@ MStatus AlembicPoints::Save(double time, unsigned int timeIndex,
     mAttrs->write();
   }
 
-  // prepare the bounding box
-  Abc::Box3d bbox;
-
-  // access the points
-  MVectorArray vectors;
-  node.position(vectors);
+  // the conversions are left to the packet, which gets plain copies of the
+  // Maya arrays
+  {
+    ESS_PROFILE_SCOPE("AlembicPoints::Save copy particles");
+    MVectorArray vectors;
+    MDoubleArray doubles;
+    MIntArray ids;
+    node.position(vectors);
+    copyMayaArray(vectors, packet->positions);
+    node.velocity(vectors);
+    copyMayaArray(vectors, packet->velocities);
+    node.radius(doubles);
+    copyMayaArray(doubles, packet->radii);
+    node.particleIds(ids);
+    copyMayaArray(ids, packet->ids);
+    node.age(doubles);
+    copyMayaArray(doubles, packet->ages);
+    node.mass(doubles);
+    copyMayaArray(doubles, packet->masses);
+    packet->hasColors = node.hasOpacity() || node.hasRgb();
+    if (packet->hasColors) {
+      node.rgb(vectors);
+      copyMayaArray(vectors, packet->rgbs);
+      node.opacity(doubles);
+      copyMayaArray(doubles, packet->opacities);
+    }
+  }
 
   // check if we have the global cache option
-  const bool globalCache =
+  packet->globalCache =
       GetJob()->GetOption(L"exportInGlobalSpace").asInt() > 0;
-  Abc::M44f globalXfo;
-  if (globalCache) {
-    globalXfo = GetGlobalMatrix(GetRef());
+  if (packet->globalCache) {
+    packet->globalXfo = GetGlobalMatrix(GetRef());
   }
 
   // instance names, scale,
@@ -199,101 +365,6 @@ MStatus AlembicPoints::Save(double time, unsigned int timeIndex,
     listIntanceNames(instanceNames);
   }
 
-  // push the positions to the bbox
-  size_t particleCount = vectors.length();
-  std::vector<Abc::V3f> posVec(particleCount);
-  for (unsigned int i = 0; i < vectors.length(); i++) {
-    const MVector &out = vectors[i];
-    Abc::V3f &in = posVec[i];
-    in.x = (float)out.x;
-    in.y = (float)out.y;
-    in.z = (float)out.z;
-    if (globalCache) {
-      globalXfo.multVecMatrix(in, in);
-    }
-    bbox.extendBy(in);
-  }
-  vectors.clear();
-
-  // get the velocities
-  node.velocity(vectors);
-  std::vector<Abc::V3f> velVec(particleCount);
-  for (unsigned int i = 0; i < vectors.length(); i++) {
-    const MVector &out = vectors[i];
-    Abc::V3f &in = velVec[i];
-    in.x = (float)out.x;
-    in.y = (float)out.y;
-    in.z = (float)out.z;
-    if (globalCache) {
-      globalXfo.multDirMatrix(in, in);
-    }
-  }
-  vectors.clear();
-
-  // get the widths
-  MDoubleArray doubles;
-  node.radius(doubles);
-  std::vector<float> widthVec(particleCount);
-  for (unsigned int i = 0; i < doubles.length(); i++) {
-    widthVec[i] = (float)doubles[i];
-  }
-  doubles.clear();
-
-  // get the ids
-  std::vector<Abc::uint64_t> idVec(particleCount);
-  MIntArray ints;
-  node.particleIds(ints);
-  for (unsigned int i = 0; i < ints.length(); i++) {
-    idVec[i] = (Abc::uint64_t)ints[i];
-  }
-  ints.clear();
-
-  // get the age
-  node.age(doubles);
-  std::vector<float> ageVec(particleCount);
-  for (unsigned int i = 0; i < doubles.length(); i++) {
-    ageVec[i] = (float)doubles[i];
-  }
-  doubles.clear();
-
-  // get the mass
-  node.mass(doubles);
-  std::vector<float> massVec(particleCount);
-  for (unsigned int i = 0; i < doubles.length(); i++) {
-    massVec[i] = (float)doubles[i];
-  }
-  doubles.clear();
-
-  // get the color
-  std::vector<Abc::C4f> colorVec;
-  if (node.hasOpacity() || node.hasRgb()) {
-    colorVec.resize(particleCount);
-    node.rgb(vectors);
-    node.opacity(doubles);
-    for (unsigned int i = 0; i < doubles.length(); i++) {
-      const MVector &out = vectors[i];
-      Imath::C4f &in = colorVec[i];
-      in.r = (float)out.x;
-      in.g = (float)out.y;
-      in.b = (float)out.z;
-      in.a = (float)doubles[i];
-    }
-    vectors.clear();
-    doubles.clear();
-  }
-
-  mSample.setSelfBounds(bbox);
-
-  // setup the sample
-  mSample.setPositions(Abc::P3fArraySample(posVec));
-  mSample.setVelocities(Abc::V3fArraySample(velVec));
-  mSample.setWidths(AbcG::OFloatGeomParam::Sample(
-      Abc::FloatArraySample(widthVec), AbcG::kVertexScope));
-  mSample.setIds(Abc::UInt64ArraySample(idVec));
-  mAgeProperty.set(Abc::FloatArraySample(ageVec));
-  mMassProperty.set(Abc::FloatArraySample(massVec));
-  mColorProperty.set(Abc::C4fArraySample(colorVec));
-
   //--- instancing!!
   std::vector<Abc::Quatf> angularVel, orientation;
   std::vector<Abc::uint16_t> shapeId, shapeType;
@@ -303,7 +374,7 @@ MStatus AlembicPoints::Save(double time, unsigned int timeIndex,
                              shapeTime);
 
   // save the sample
-  mSchema.set(mSample);
+  GetJob()->QueueSample(packetPtr);
   mNumSamples++;
 
   return MStatus::kSuccess;
@@ -742,6 +813,9 @@ void AlembicPointsNode::PreDestruction()
   }
 
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
+  mParticles.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -878,16 +952,130 @@ static MVector quaternionToVector(const Abc::Quatf &qf,
   return MVector(vec.x, vec.y, vec.z);
 }
 
-static bool useAngularVelocity(Abc::QuatfArraySamplePtr &velPtr,
-                               const AbcG::IPoints &obj,
-                               Alembic::AbcCoreAbstract::index_t floorIndex)
+void ParticleState::clear()
 {
-  Abc::IQuatfArrayProperty velProp;
-  if (getArbGeomParamPropertyAlembic(obj, "angularvelocity", velProp)) {
-    velPtr = velProp.getValue(floorIndex);
-    return (velPtr != NULL && velPtr->size() != 0);
+  slotIds.clear();
+  sampleSlots.clear();
+  inOrder = true;
+  validIdsKey = false;
+  positionsSource.valid = false;
+  velocitiesSource.valid = false;
+  colorsSource.valid = false;
+  agesSource.valid = false;
+  massesSource.valid = false;
+  shapeInstIdsSource.valid = false;
+  orientationsSource.valid = false;
+}
+
+// Gathers the keys of the samples a channel is computed from, a property
+// which is not in the file has an empty key.
+class ChannelKeys {
+ public:
+  ChannelKeys(const Abc::ISampleSelector &sel) : mSel(sel), mComplete(true) {}
+
+  template <class PROP>
+  ChannelKeys &add(const PROP &prop)
+  {
+    AbcA::ArraySampleKey key;
+    if (prop.valid() && !prop.getKey(key, mSel)) {
+      mComplete = false;
+    }
+    mKeys.push_back(key);
+    return *this;
   }
-  return false;
+
+  // returns true if the channel has to be written again, and remembers the
+  // keys it is written from
+  bool update(ParticleChannelSource &source, bool layoutChanged,
+              float alpha = 0.0f)
+  {
+    if (source.valid && !layoutChanged && source.alpha == alpha &&
+        source.keys == mKeys) {
+      return false;
+    }
+    source.keys.swap(mKeys);
+    source.alpha = alpha;
+    source.valid = mComplete;
+    return true;
+  }
+
+ private:
+  Abc::ISampleSelector mSel;
+  std::vector<AbcA::ArraySampleKey> mKeys;
+  bool mComplete;
+};
+
+// Places the ids of the sample in the particles of the previous frame. Both
+// id lists are sorted and merged: the surviving ids keep their particle, the
+// born ids take the particles left by the dead ones and the ones beyond the
+// new count. Returns true if a particle changed of id.
+static bool layoutParticles(const Abc::uint64_t *ids, unsigned int count,
+                            ParticleState &state)
+{
+  ESS_PROFILE_SCOPE("layoutParticles");
+  typedef std::pair<Abc::uint64_t, unsigned int> IdSlot;
+  const unsigned int prevCount = (unsigned int)state.slotIds.size();
+
+  std::vector<IdSlot> newIds(count);
+  for (unsigned int i = 0; i < count; ++i) {
+    newIds[i] = IdSlot(ids[i], i);
+  }
+  if (!std::is_sorted(newIds.begin(), newIds.end())) {
+    std::sort(newIds.begin(), newIds.end());
+  }
+  std::vector<IdSlot> prevIds(prevCount);
+  for (unsigned int i = 0; i < prevCount; ++i) {
+    prevIds[i] = IdSlot(state.slotIds[i], i);
+  }
+  if (!std::is_sorted(prevIds.begin(), prevIds.end())) {
+    std::sort(prevIds.begin(), prevIds.end());
+  }
+
+  // the survivors whose particle is still in the range keep it
+  const unsigned int unset = (unsigned int)-1;
+  std::vector<unsigned int> slots(count, unset);
+  std::vector<bool> used(count, false);
+  size_t n = 0, p = 0;
+  while (n < count && p < prevCount) {
+    if (newIds[n].first < prevIds[p].first) {
+      ++n;
+    }
+    else if (prevIds[p].first < newIds[n].first) {
+      ++p;
+    }
+    else {
+      const unsigned int slot = prevIds[p].second;
+      if (slot < count) {
+        slots[newIds[n].second] = slot;
+        used[slot] = true;
+      }
+      ++n;
+      ++p;
+    }
+  }
+
+  // the born ones and the survivors beyond the new count take the free ones
+  bool changed = (count != prevCount);
+  unsigned int freeSlot = 0;
+  for (unsigned int i = 0; i < count; ++i) {
+    if (slots[i] == unset) {
+      while (used[freeSlot]) {
+        ++freeSlot;
+      }
+      slots[i] = freeSlot;
+      used[freeSlot] = true;
+      changed = true;
+    }
+  }
+
+  state.slotIds.resize(count);
+  state.inOrder = true;
+  for (unsigned int i = 0; i < count; ++i) {
+    state.slotIds[slots[i]] = ids[i];
+    state.inOrder = state.inOrder && (slots[i] == i);
+  }
+  state.sampleSlots.swap(slots);
+  return changed;
 }
 
 MStatus AlembicPointsNode::compute(const MPlug &plug, MDataBlock &dataBlock)
@@ -927,6 +1115,9 @@ MStatus AlembicPointsNode::compute(const MPlug &plug, MDataBlock &dataBlock)
   const MString &identifier = dataBlock.inputValue(mIdentifierAttr).asString();
 
   // check if we have the file
+  if (fileName != mFileName || identifier != mIdentifier) {
+    mParticles.clear();
+  }
   if (!(status = init(fileName, identifier))) {
     return status;
   }
@@ -946,6 +1137,7 @@ MStatus AlembicPointsNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     return MStatus::kSuccess;
   }
 
+  const bool rewind = inputTime <= mLastInputTime;
   mLastInputTime = inputTime;
   mLastSampleInfo = sampleInfo;
 
@@ -953,8 +1145,9 @@ MStatus AlembicPointsNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     ESS_PROFILE_SCOPE("AlembicPointsNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -968,203 +1161,250 @@ MStatus AlembicPointsNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     }
   }
 
-  // access the points values
-  AbcG::IPointsSchema::Sample sample;
-  mSchema.get(sample, sampleInfo.floorIndex);
+  // the particles were changed outside of this node, for example when the
+  // particle shape is reset at its start frame. Going back in time or
+  // evaluating the same time again rewrites every channel too, the particle
+  // shape may have been reset with the same count.
+  ParticleState &state = mParticles;
+  if (rewind || (unsigned int)part.count() != state.slotIds.size()) {
+    state.clear();
+  }
+
+  // access the points properties
+  const Abc::ISampleSelector floorSel(sampleInfo.floorIndex);
+  Abc::IP3fArrayProperty propPos = mSchema.getPositionsProperty();
+  Abc::IUInt64ArrayProperty propIds = mSchema.getIdsProperty();
+  Abc::IV3fArrayProperty propVel = mSchema.getVelocitiesProperty();
+  Abc::IC4fArrayProperty propColor;
+  getArbGeomParamPropertyAlembic(obj, "color", propColor);
+  Abc::IFloatArrayProperty propAge;
+  getArbGeomParamPropertyAlembic(obj, "age", propAge);
+  Abc::IFloatArrayProperty propMass;
+  getArbGeomParamPropertyAlembic(obj, "mass", propMass);
+  Abc::IUInt16ArrayProperty propShapeInstanceID;
+  getArbGeomParamPropertyAlembic(obj, "shapeinstanceid", propShapeInstanceID);
+  Abc::IQuatfArrayProperty propOrientation;
+  getArbGeomParamPropertyAlembic(obj, "orientation", propOrientation);
+  Abc::IQuatfArrayProperty propAngVel;
+  getArbGeomParamPropertyAlembic(obj, "angularvelocity", propAngVel);
+
+  Abc::P3fArraySamplePtr samplePos = propPos.getValue(floorSel);
+  Abc::V3fArraySamplePtr sampleVel;
+  if (propVel.valid()) {
+    sampleVel = propVel.getValue(floorSel);
+  }
 
-  // get all of the data from alembic
-  Abc::UInt64ArraySamplePtr sampleIds = sample.getIds();
-  Abc::P3fArraySamplePtr samplePos = sample.getPositions();
-  Abc::V3fArraySamplePtr sampleVel = sample.getVelocities();
+  // check if this is a valid sample
+  unsigned int particleCount = samplePos ? (unsigned int)samplePos->size() : 0;
 
-  Abc::C4fArraySamplePtr sampleColor;
-  {
-    Abc::IC4fArrayProperty propColor;
-    if (getArbGeomParamPropertyAlembic(obj, "color", propColor)) {
-      sampleColor = propColor.getValue(sampleInfo.floorIndex);
-    }
-  }
-  Abc::FloatArraySamplePtr sampleAge;
-  {
-    Abc::IFloatArrayProperty propAge;
-    if (getArbGeomParamPropertyAlembic(obj, "age", propAge)) {
-      sampleAge = propAge.getValue(sampleInfo.floorIndex);
-    }
-  }
-  Abc::FloatArraySamplePtr sampleMass;
+  // the ids are only merged again when they changed
+  bool layoutChanged = false;
   {
-    Abc::IFloatArrayProperty propMass;
-    if (getArbGeomParamPropertyAlembic(obj, "mass", propMass)) {
-      sampleMass = propMass.getValue(sampleInfo.floorIndex);
-    }
-  }
-  Abc::UInt16ArraySamplePtr sampleShapeInstanceID;
-  {
-    Abc::IUInt16ArrayProperty propShapeInstanceID;
-    if (getArbGeomParamPropertyAlembic(obj, "shapeinstanceid",
-                                       propShapeInstanceID))
-      sampleShapeInstanceID =
-          propShapeInstanceID.getValue(sampleInfo.floorIndex);
-  }
-  Abc::QuatfArraySamplePtr sampleOrientation;
-  {
-    Abc::IQuatfArrayProperty propOrientation;
-    if (getArbGeomParamPropertyAlembic(obj, "orientation", propOrientation)) {
-      sampleOrientation = propOrientation.getValue(sampleInfo.floorIndex);
-    }
-  }
-
-  // get the current values from the particle cloud
-  MIntArray ids;
-  part.particleIds(ids);
-  MVectorArray positions;
-  part.position(positions);
-  MVectorArray velocities;
-  part.velocity(velocities);
-  MVectorArray rgbs;
-  part.rgb(rgbs);
-  MDoubleArray opacities;
-  part.opacity(opacities);
-  MDoubleArray ages;
-  part.age(ages);
-  MDoubleArray masses;
-  part.mass(masses);
-  MDoubleArray shapeInstId;
-  part.getPerParticleAttribute("shapeInstanceIdPP", shapeInstId);
-  MVectorArray orientationPP;
-  part.getPerParticleAttribute("orientationPP", orientationPP, &status);
-  if (status != MS::kSuccess)
-    MGlobal::displayError("readFromParticle w/ orientationPP --> " +
-                          status.errorString());
-
-  // arbGeomProperties->readFromParticle(part);
+    AbcA::ArraySampleKey idsKey;
+    const bool validIdsKey = propIds.getKey(idsKey, floorSel);
+    if (!state.validIdsKey || !validIdsKey || !(idsKey == state.idsKey) ||
+        particleCount != state.slotIds.size()) {
+      Abc::UInt64ArraySamplePtr sampleIds = propIds.getValue(floorSel);
+      if (sampleIds && sampleIds->size() == 1 &&
+          sampleIds->get()[0] == (Abc::uint64_t)-1) {
+        particleCount = 0;
+      }
 
-  // check if this is a valid sample
-  unsigned int particleCount = (unsigned int)samplePos->size();
-  if (sampleIds->size() == 1) {
-    if (sampleIds->get()[0] == (Abc::uint64_t)-1) {
-      particleCount = 0;
+      if (sampleIds && sampleIds->size() == particleCount) {
+        layoutChanged =
+            layoutParticles(sampleIds->get(), particleCount, state);
+      }
+      else {
+        // without ids the particles follow the order of the points
+        std::vector<Abc::uint64_t> indices(particleCount);
+        for (unsigned int i = 0; i < particleCount; ++i) {
+          indices[i] = i;
+        }
+        layoutChanged = layoutParticles(
+            particleCount ? &indices[0] : NULL, particleCount, state);
+      }
+      state.idsKey = idsKey;
+      state.validIdsKey = validIdsKey;
     }
   }
-  //*
+
   // ensure to have the right amount of particles
-  if (positions.length() > particleCount) {
+  const unsigned int currentCount = (unsigned int)part.count();
+  if (currentCount > particleCount) {
     part.setCount(particleCount);
   }
-  else {
-    const int deltaCount = particleCount - positions.length();
-    MPointArray emitted(deltaCount);
+  else if (currentCount < particleCount) {
+    MPointArray emitted(particleCount - currentCount);
     part.emit(emitted);
   }
-  //*
-  positions.setLength(particleCount);
-  velocities.setLength(particleCount);
-  rgbs.setLength(particleCount);
-  opacities.setLength(particleCount);
-  ages.setLength(particleCount);
-  masses.setLength(particleCount);
-  shapeInstId.setLength(particleCount);
-  orientationPP.setLength(particleCount);
 
-  // arbGeomProperties->readFromAbc(sampleInfo.floorIndex, particleCount);
-
-  // if we need to emit new particles, do that now
   if (particleCount > 0) {
-    const bool validVel = sampleVel && sampleVel->get();
-    const bool validCol = sampleColor && sampleColor->get();
-    const bool validAge = sampleAge && sampleAge->get();
-    const bool validMas = sampleMass && sampleMass->get();
-    const bool validSid = sampleShapeInstanceID && sampleShapeInstanceID->get();
-    const bool validOri = sampleOrientation && sampleOrientation->get();
+    const unsigned int *slots = &state.sampleSlots[0];
     const float timeAlpha = getTimeOffsetFromSchema(mSchema, sampleInfo);
+    const bool validVel = sampleVel && sampleVel->get();
 
-    const bool velUseFirstSample = validVel && (sampleVel->size() == 1);
-    const bool colUseFirstSample = validCol && (sampleColor->size() == 1);
-    const bool ageUseFirstSample = validAge && (sampleAge->size() == 1);
-    const bool masUseFirstSample = validMas && (sampleMass->size() == 1);
-    const bool sidUseFirstSample =
-        validSid && (sampleShapeInstanceID->size() == 1);
-    const bool oriUseFirstSample = validOri && (sampleOrientation->size() == 1);
-    for (unsigned int i = 0; i < particleCount; ++i) {
-      //*
-      const Alembic::Abc::V3f &pout = samplePos->get()[i];
-      MVector &pin = positions[i];
-      pin.x = pout.x;
-      pin.y = pout.y;
-      pin.z = pout.z;
-
-      if (validVel) {
-        const Alembic::Abc::V3f &out =
-            sampleVel->get()[velUseFirstSample ? 0 : i];
-        MVector &in = velocities[i];
-        in.x = out.x;
-        in.y = out.y;
-        in.z = out.z;
-
-        pin += in * timeAlpha;
+    // the positions are moved according to the velocities
+    if (ChannelKeys(floorSel).add(propPos).add(propVel).update(
+            state.positionsSource, layoutChanged,
+            validVel ? timeAlpha : 0.0f)) {
+      ESS_PROFILE_SCOPE("AlembicPointsNode::compute positions");
+      PointsInterpolator interpolator(
+          samplePos, Abc::P3fArraySamplePtr(),
+          validVel ? sampleVel : Abc::V3fArraySamplePtr(),
+          Abc::V3fArraySamplePtr(), timeAlpha);
+      if (state.inOrder) {
+        interpolator.compute(state.positions, 0, particleCount);
+      }
+      else {
+        interpolator.compute(state.scratch, 0, particleCount);
+        state.positions.setLength(particleCount);
+        for (unsigned int i = 0; i < particleCount; ++i) {
+          const Abc::V3f &out = state.scratch[i];
+          state.positions[slots[i]] = MVector(out.x, out.y, out.z);
+        }
       }
+      part.setPerParticleAttribute("position", state.positions);
+    }
 
-      if (validCol) {
-        const Alembic::Abc::C4f &out =
-            sampleColor->get()[colUseFirstSample ? 0 : i];
-        MVector &in = rgbs[i];
-        in.x = out.r;
-        in.y = out.g;
-        in.z = out.b;
-        opacities[i] = out.a;
+    if (ChannelKeys(floorSel).add(propVel).update(state.velocitiesSource,
+                                                 layoutChanged)) {
+      const bool useFirstSample = validVel && (sampleVel->size() == 1);
+      state.velocities.setLength(particleCount);
+      for (unsigned int i = 0; i < particleCount; ++i) {
+        MVector &in = state.velocities[slots[i]];
+        if (validVel) {
+          const Abc::V3f &out = sampleVel->get()[useFirstSample ? 0 : i];
+          in.x = out.x;
+          in.y = out.y;
+          in.z = out.z;
+        }
+        else {
+          in = MVector::zero;
+        }
       }
-      else {
-        rgbs[i] = MVector(0.0, 0.0, 0.0);
-        opacities[i] = 1.0;
+    }
+    // the solver of the particle shape resets the velocities at each step
+    // since conserve is 0, so they are given back every time
+    part.setPerParticleAttribute("velocity", state.velocities);
+
+    if (ChannelKeys(floorSel).add(propColor).update(state.colorsSource,
+                                                   layoutChanged)) {
+      Abc::C4fArraySamplePtr sampleColor;
+      if (propColor.valid()) {
+        sampleColor = propColor.getValue(floorSel);
+      }
+      const bool validCol = sampleColor && sampleColor->get();
+      const bool useFirstSample = validCol && (sampleColor->size() == 1);
+      state.rgbs.setLength(particleCount);
+      state.opacities.setLength(particleCount);
+      for (unsigned int i = 0; i < particleCount; ++i) {
+        const unsigned int slot = slots[i];
+        if (validCol) {
+          const Abc::C4f &out = sampleColor->get()[useFirstSample ? 0 : i];
+          MVector &in = state.rgbs[slot];
+          in.x = out.r;
+          in.y = out.g;
+          in.z = out.b;
+          state.opacities[slot] = out.a;
+        }
+        else {
+          state.rgbs[slot] = MVector(0.0, 0.0, 0.0);
+          state.opacities[slot] = 1.0;
+        }
       }
+      part.setPerParticleAttribute("rgbPP", state.rgbs);
+      part.setPerParticleAttribute("opacityPP", state.opacities);
+    }
 
-      ages[i] = validAge ? sampleAge->get()[ageUseFirstSample ? 0 : i] : 0.0;
-      shapeInstId[i] =
-          validSid ? sampleShapeInstanceID->get()[sidUseFirstSample ? 0 : i]
-                   : 0.0;
-      if (validMas) {
-        const double mass = sampleMass->get()[masUseFirstSample ? 0 : i];
-        masses[i] = mass > 0.0 ? mass : 1.0;
+    if (ChannelKeys(floorSel).add(propAge).update(state.agesSource,
+                                                 layoutChanged)) {
+      Abc::FloatArraySamplePtr sampleAge;
+      if (propAge.valid()) {
+        sampleAge = propAge.getValue(floorSel);
       }
-      else {
-        masses[i] = 1.0;
+      const bool validAge = sampleAge && sampleAge->get();
+      const bool useFirstSample = validAge && (sampleAge->size() == 1);
+      state.ages.setLength(particleCount);
+      for (unsigned int i = 0; i < particleCount; ++i) {
+        state.ages[slots[i]] =
+            validAge ? sampleAge->get()[useFirstSample ? 0 : i] : 0.0;
       }
-      //*
+      part.setPerParticleAttribute("agePP", state.ages);
     }
 
-    // compute the right orientation with the angular velocity if necessary!
-    //*
-    if (validOri) {
-      Abc::QuatfArraySamplePtr velPtr;
-      const bool useAngVel =
-          timeAlpha != 0.0f &&
-          useAngularVelocity(velPtr, obj, sampleInfo.floorIndex);
-      const bool angUseFirstSample = useAngVel && (velPtr->size() == 1);
+    if (ChannelKeys(floorSel).add(propMass).update(state.massesSource,
+                                                  layoutChanged)) {
+      Abc::FloatArraySamplePtr sampleMass;
+      if (propMass.valid()) {
+        sampleMass = propMass.getValue(floorSel);
+      }
+      const bool validMas = sampleMass && sampleMass->get();
+      const bool useFirstSample = validMas && (sampleMass->size() == 1);
+      state.masses.setLength(particleCount);
       for (unsigned int i = 0; i < particleCount; ++i) {
-        const Abc::Quatf angVel =
-            (useAngVel ? velPtr->get()[angUseFirstSample ? 0 : i] * timeAlpha
-                       : Abc::Quatf());
-        orientationPP[i] = quaternionToVector(
-            sampleOrientation->get()[oriUseFirstSample ? 0 : i], angVel);
+        const double mass =
+            validMas ? sampleMass->get()[useFirstSample ? 0 : i] : 1.0;
+        state.masses[slots[i]] = mass > 0.0 ? mass : 1.0;
       }
+      part.setPerParticleAttribute("massPP", state.masses);
     }
-    else {
+
+    if (ChannelKeys(floorSel).add(propShapeInstanceID).update(
+            state.shapeInstIdsSource, layoutChanged)) {
+      Abc::UInt16ArraySamplePtr sampleShapeInstanceID;
+      if (propShapeInstanceID.valid()) {
+        sampleShapeInstanceID = propShapeInstanceID.getValue(floorSel);
+      }
+      const bool validSid =
+          sampleShapeInstanceID && sampleShapeInstanceID->get();
+      const bool useFirstSample =
+          validSid && (sampleShapeInstanceID->size() == 1);
+      state.shapeInstIds.setLength(particleCount);
       for (unsigned int i = 0; i < particleCount; ++i) {
-        orientationPP[i] = MVector::zero;
+        state.shapeInstIds[slots[i]] =
+            validSid ? sampleShapeInstanceID->get()[useFirstSample ? 0 : i]
+                     : 0.0;
       }
-    }  //*
-  }
-
-  // take care of the remaining attributes
-  part.setPerParticleAttribute("position", positions);
-  part.setPerParticleAttribute("velocity", velocities);
-  part.setPerParticleAttribute("rgbPP", rgbs);
-  part.setPerParticleAttribute("opacityPP", opacities);
-  part.setPerParticleAttribute("agePP", ages);
-  part.setPerParticleAttribute("massPP", masses);
-  part.setPerParticleAttribute("shapeInstanceIdPP", shapeInstId);
-  part.setPerParticleAttribute("orientationPP", orientationPP);
-  //*/
+      part.setPerParticleAttribute("shapeInstanceIdPP", state.shapeInstIds);
+    }
+
+    // compute the right orientation with the angular velocity if necessary!
+    const bool useAngVel = timeAlpha != 0.0f && propAngVel.valid();
+    if (ChannelKeys(floorSel)
+            .add(propOrientation)
+            .add(useAngVel ? propAngVel : Abc::IQuatfArrayProperty())
+            .update(state.orientationsSource, layoutChanged,
+                    useAngVel ? timeAlpha : 0.0f)) {
+      Abc::QuatfArraySamplePtr sampleOrientation;
+      if (propOrientation.valid()) {
+        sampleOrientation = propOrientation.getValue(floorSel);
+      }
+      state.orientations.setLength(particleCount);
+      if (sampleOrientation && sampleOrientation->get()) {
+        const bool oriUseFirstSample = (sampleOrientation->size() == 1);
+        Abc::QuatfArraySamplePtr velPtr;
+        if (useAngVel) {
+          velPtr = propAngVel.getValue(floorSel);
+        }
+        const bool validAngVel = velPtr && velPtr->size() != 0;
+        const bool angUseFirstSample = validAngVel && (velPtr->size() == 1);
+        for (unsigned int i = 0; i < particleCount; ++i) {
+          const Abc::Quatf angVel =
+              (validAngVel
+                   ? velPtr->get()[angUseFirstSample ? 0 : i] * timeAlpha
+                   : Abc::Quatf());
+          state.orientations[slots[i]] = quaternionToVector(
+              sampleOrientation->get()[oriUseFirstSample ? 0 : i], angVel);
+        }
+      }
+      else {
+        for (unsigned int i = 0; i < particleCount; ++i) {
+          state.orientations[i] = MVector::zero;
+        }
+      }
+      part.setPerParticleAttribute("orientationPP", state.orientations);
+    }
+  }
   // arbGeomProperties->setParticleProperty(part);
 
   hOut.set(dOutput);
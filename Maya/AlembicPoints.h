@@ -1,10 +1,12 @@
 #ifndef _ALEMBIC_POINTS_H_
 #define _ALEMBIC_POINTS_H_
 
+#include <maya/MDoubleArray.h>
 #include <maya/MFnInstancer.h>
 #include <maya/MFnParticleSystem.h>
 #include <list>
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 class AlembicPoints : public AlembicObject {
@@ -14,7 +16,6 @@ class AlembicPoints : public AlembicObject {
 
   AbcG::OPoints mObject;
   AbcG::OPointsSchema mSchema;
-  AbcG::OPointsSchema::Sample mSample;
 
   AttributesWriterPtr mAttrs;
 
@@ -97,6 +98,48 @@ class ArbGeomProperties {
   std::vector<BasePropertyManagerPtr> baseProperties;
 };
 
+// The keys of the samples a particle channel was last written from, the
+// channel is only written again when one of them changes.
+struct ParticleChannelSource {
+  std::vector<AbcA::ArraySampleKey> keys;
+  float alpha;
+  bool valid;
+
+  ParticleChannelSource() : alpha(0.0f), valid(false) {}
+};
+
+// Per particle state kept by AlembicPointsNode between two frames. Each Maya
+// particle keeps the Alembic id it was given for as long as that id lives, the
+// born ids take the particles of the dead ones.
+struct ParticleState {
+  std::vector<Abc::uint64_t> slotIds;     // the Alembic id of each particle
+  std::vector<unsigned int> sampleSlots;  // the particle of each sample point
+  bool inOrder;  // sampleSlots is the identity
+  AbcA::ArraySampleKey idsKey;
+  bool validIdsKey;
+
+  MVectorArray positions;
+  MVectorArray velocities;
+  MVectorArray rgbs;
+  MDoubleArray opacities;
+  MDoubleArray ages;
+  MDoubleArray masses;
+  MDoubleArray shapeInstIds;
+  MVectorArray orientations;
+  std::vector<Abc::V3f> scratch;
+
+  ParticleChannelSource positionsSource;
+  ParticleChannelSource velocitiesSource;
+  ParticleChannelSource colorsSource;
+  ParticleChannelSource agesSource;
+  ParticleChannelSource massesSource;
+  ParticleChannelSource shapeInstIdsSource;
+  ParticleChannelSource orientationsSource;
+
+  ParticleState() : inOrder(true), validIdsKey(false) {}
+  void clear();
+};
+
 class AlembicPointsNode;
 
 typedef std::list<AlembicPointsNode *> AlembicPointsNodeList;
@@ -131,6 +174,8 @@ class AlembicPointsNode : public AlembicObjectEmitterNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::IPointsSchema mSchema;
   AbcG::IPoints obj;
   AlembicPointsNodeListIter listPosition;
@@ -145,6 +190,7 @@ class AlembicPointsNode : public AlembicObjectEmitterNode {
   // members
   SampleInfo mLastSampleInfo;
   double mLastInputTime;
+  ParticleState mParticles;
   // ArbGeomProperties *arbGeomProperties;
 };
 
@@ -4,6 +4,94 @@
 #include "AttributesReading.h"
 #include "CommonMeshUtilities.h"
 #include "MetaData.h"
+#include "PointsInterpolation.h"
+
+// the sample of a frame with the arrays it points to
+class AlembicPolyMeshPacket : public AlembicSamplePacket {
+ public:
+  AlembicPolyMeshPacket(const AbcG::OPolyMeshSchema &schema)
+      : globalCache(false), hasNormals(false), mSchema(schema)
+  {
+  }
+
+  // the conversions which don't need Maya, run beside the other objects
+  virtual void convert()
+  {
+    ESS_PROFILE_SCOPE("AlembicPolyMeshPacket::convert");
+    Abc::Box3d bbox;
+    posVec.resize(points.size() / 4);
+    for (size_t i = 0; i < posVec.size(); i++) {
+      const float *ptOut = &points[i * 4];
+      Abc::V3f &ptIn = posVec[i];
+      ptIn.x = ptOut[0];
+      ptIn.y = ptOut[1];
+      ptIn.z = ptOut[2];
+      if (globalCache) {
+        globalXfo.multVecMatrix(ptIn, ptIn);
+      }
+      bbox.extendBy(ptIn);
+    }
+    std::vector<float>().swap(points);
+    sample.setPositions(Abc::P3fArraySample(posVec));
+    sample.setSelfBounds(bbox);
+
+    if (!hasNormals) {
+      return;
+    }
+    normalsValues.resize(normals.size() / 3);
+    for (size_t i = 0; i < normalsValues.size(); ++i) {
+      const float *nOut = &normals[i * 3];
+      Abc::N3f &nIn = normalsValues[i];
+      nIn.x = nOut[0];
+      nIn.y = nOut[1];
+      nIn.z = nOut[2];
+    }
+    std::vector<float>().swap(normals);
+
+    // the face vertices are stored in the reverse order
+    normalsIndices.resize(normalIds.size());
+    for (size_t i = 0, offset = 0; i < normalCounts.size(); ++i) {
+      const size_t cnt = (size_t)normalCounts[i];
+      for (size_t j = 0; j < cnt; ++j) {
+        normalsIndices[offset + cnt - (j + 1)] = normalIds[offset + j];
+      }
+      offset += cnt;
+    }
+    std::vector<int>().swap(normalIds);
+
+    AbcG::ON3fGeomParam::Sample normalSample;
+    normalSample.setScope(AbcG::kFacevaryingScope);
+    normalSample.setVals(Abc::N3fArraySample(normalsValues));
+    normalSample.setIndices(Abc::UInt32ArraySample(normalsIndices));
+    sample.setNormals(normalSample);
+  }
+
+  virtual void write()
+  {
+    ESS_PROFILE_SCOPE("AlembicPolyMeshPacket::write");
+    mSchema.set(sample);
+  }
+
+  // copied from Maya by Save
+  std::vector<float> points;
+  bool globalCache;
+  Abc::M44f globalXfo;
+  bool hasNormals;
+  std::vector<float> normals;
+  std::vector<int> normalCounts;
+  std::vector<int> normalIds;
+
+  AbcG::OPolyMeshSchema::Sample sample;
+  std::vector<Abc::V3f> posVec;
+  std::vector<Abc::int32_t> faceCountVec;
+  std::vector<Abc::int32_t> faceIndicesVec;
+  std::vector<IndexedUVs> indexedUVSet;
+  std::vector<Abc::N3f> normalsValues;
+  std::vector<unsigned int> normalsIndices;
+
+ private:
+  AbcG::OPolyMeshSchema mSchema;
+};
 
 AlembicPolyMesh::AlembicPolyMesh(SceneNodePtr eNode, AlembicWriteJob *in_Job,
                                  Abc::OObject oParent)
@@ -34,11 +122,13 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
   MDagPath path;
   node.getPath(path);
 
-  // save the metadata
-  std::vector<Abc::V3f> mPosVec;
-
-  mSample.reset();
+  // the arrays of the sample belong to the packet, it is stored in the
+  // archive after the other objects of the frame are saved
+  AlembicPolyMeshPacket *packet = new AlembicPolyMeshPacket(mSchema);
+  AlembicSamplePacketPtr packetPtr(packet);
+  AbcG::OPolyMeshSchema::Sample &sample = packet->sample;
 
+  // save the metadata
   SaveMetaData(this);
 
   // save the attributes
@@ -58,14 +148,12 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
     mAttrs->write();
   }
 
-  // prepare the bounding box
-  Abc::Box3d bbox;
-
   // access the points
   MFloatPointArray points;
   {
     ESS_PROFILE_SCOPE("AlembicPolyMesh::Save get node points");
     node.getPoints(points);
+    copyMayaArray(points, packet->points);
   }
 
   std::vector<std::vector<Alembic::Util::int32_t> > allFaceSetVals;  // keep in
@@ -78,12 +166,11 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
   // written!
 
   // check if we have the global cache option
-  const bool globalCache =
+  packet->globalCache =
       GetJob()->GetOption(L"exportInGlobalSpace").asInt() > 0;
-  Abc::M44f globalXfo;
-  if (globalCache) {
+  if (packet->globalCache) {
     ESS_PROFILE_SCOPE("AlembicPolyMesh::Save get global xfo");
-    globalXfo = GetGlobalMatrix(GetRef());
+    packet->globalXfo = GetGlobalMatrix(GetRef());
   }
 
   // ensure to keep the same topology if dynamic topology is disabled
@@ -103,37 +190,17 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
   }
   mPointCountLastFrame = points.length();
 
-  {
-    ESS_PROFILE_SCOPE("AlembicPolyMesh::Save point copy, bbox extend, gspace");
-    mPosVec.resize(points.length());
-    for (unsigned int i = 0; i < points.length(); i++) {
-      const MFloatVector &ptOut = points[i];
-      Abc::V3f &ptIn = mPosVec[i];
-      ptIn.x = ptOut.x;
-      ptIn.y = ptOut.y;
-      ptIn.z = ptOut.z;
-      if (globalCache) {
-        globalXfo.multVecMatrix(ptIn, ptIn);
-      }
-      bbox.extendBy(ptIn);
-    }
-  }
-
-  // store the positions to the samples
-  mSample.setPositions(Abc::P3fArraySample(mPosVec));
-  mSample.setSelfBounds(bbox);
-
   // check if we are doing pure pointcache
-  std::vector<Abc::int32_t> mFaceCountVec;
-  std::vector<Abc::int32_t> mFaceIndicesVec;
+  std::vector<Abc::int32_t> &mFaceCountVec = packet->faceCountVec;
+  std::vector<Abc::int32_t> &mFaceIndicesVec = packet->faceIndicesVec;
   if (GetJob()->GetOption(L"exportPurePointCache").asInt() > 0) {
     ESS_PROFILE_SCOPE("AlembicPolyMesh::Save exportPurePointCache");
     if (mNumSamples == 0) {
       // store a dummy empty topology
-      mSample.setFaceCounts(Abc::Int32ArraySample(mFaceCountVec));
-      mSample.setFaceIndices(Abc::Int32ArraySample(mFaceIndicesVec));
+      sample.setFaceCounts(Abc::Int32ArraySample(mFaceCountVec));
+      sample.setFaceIndices(Abc::Int32ArraySample(mFaceIndicesVec));
     }
-    mSchema.set(mSample);
+    GetJob()->QueueSample(packetPtr);
     mNumSamples++;
     return MStatus::kSuccess;
   }
@@ -142,7 +209,7 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
   std::vector<std::vector<Abc::uint32_t> > mUvIndexVec;
 
   AbcG::OV2fGeomParam::Sample uvSample;
-  std::vector<IndexedUVs> indexedUVSet;
+  std::vector<IndexedUVs> &indexedUVSet = packet->indexedUVSet;
 
   if (mNumSamples == 0 || dynamicTopology) {
     ESS_PROFILE_SCOPE(
@@ -166,8 +233,8 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
 
     Abc::Int32ArraySample faceCountSample(mFaceCountVec);
     Abc::Int32ArraySample faceIndicesSample(mFaceIndicesVec);
-    mSample.setFaceCounts(faceCountSample);
-    mSample.setFaceIndices(faceIndicesSample);
+    sample.setFaceCounts(faceCountSample);
+    sample.setFaceIndices(faceIndicesSample);
 
     // check if we need to export uvs
     if (GetJob()->GetOption(L"exportUVs").asInt() > 0) {
@@ -236,7 +303,7 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
         }
       }
 
-      saveIndexedUVs(mSchema, mSample, uvSample, mUvParams,
+      saveIndexedUVs(mSchema, sample, uvSample, mUvParams,
                      GetJob()->GetAnimatedTs(), mNumSamples, indexedUVSet);
     }
 
@@ -377,54 +444,21 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
     }
   }
 
-  // now do the normals
-  // let's check if we have user normals
-  int normalCount = 0;
-  std::vector<Abc::N3f> indexedNormalsValues;
-  std::vector<unsigned int> indexedNormalsIndices;
+  // now do the normals, the packet indexes them
   if (GetJob()->GetOption(L"exportNormals").asInt() > 0) {
     ESS_PROFILE_SCOPE("AlembicPolyMesh::Save Normals");
-    {
-      MFloatVectorArray normalsArray;
-      node.getNormals(normalsArray);
-
-      indexedNormalsValues.resize(normalsArray.length());
-      for (int i = 0; i < indexedNormalsValues.size(); ++i) {
-        const MFloatVector &nOut = normalsArray[i];
-        Abc::N3f &nIn = indexedNormalsValues[i];
-
-        nIn.x = nOut.x;
-        nIn.y = nOut.y;
-        nIn.z = nOut.z;
-      }
-    }
-
-    {
-      MIntArray normPerFaceArray;
-      MIntArray normalIDsArray;
-      node.getNormalIds(normPerFaceArray, normalIDsArray);
-
-      // if (indexedNormalsIndices.size() == mSampleLookup.size())
-      {
-        indexedNormalsIndices.resize(normalIDsArray.length());
-        for (int i = 0; i < indexedNormalsIndices.size(); ++i) {
-          indexedNormalsIndices[mSampleLookup[i]] = normalIDsArray[i];
-        }
-      }
-    }
-
-    AbcG::ON3fGeomParam::Sample normalSample;
-    normalSample.setScope(AbcG::kFacevaryingScope);
-    normalSample.setVals(Abc::N3fArraySample(indexedNormalsValues));
-    normalSample.setIndices(Abc::UInt32ArraySample(indexedNormalsIndices));
-    mSample.setNormals(normalSample);
+    packet->hasNormals = true;
+    MFloatVectorArray normals;
+    MIntArray normalCounts, normalIds;
+    node.getNormals(normals);
+    node.getNormalIds(normalCounts, normalIds);
+    copyMayaArray(normals, packet->normals);
+    copyMayaArray(normalCounts, packet->normalCounts);
+    copyMayaArray(normalIds, packet->normalIds);
   }
 
   // save the sample
-  {
-    ESS_PROFILE_SCOPE("AlembicPolyMesh::Save mScheme.set(sample)");
-    mSchema.set(mSample);
-  }
+  GetJob()->QueueSample(packetPtr);
   mNumSamples++;
   return MStatus::kSuccess;
 }
@@ -432,6 +466,8 @@ MStatus AlembicPolyMesh::Save(double time, unsigned int timeIndex,
 void AlembicPolyMeshNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -547,15 +583,6 @@ MStatus AlembicPolyMeshNode::initialize()
   return status;
 }
 
-float C1Interpolation(float p0, float p1, float v0, float v1, float t)
-{
-  const float _1mt = 1.0f - t;
-  // return _1mt*_1mt*(p0 + t*v0) + 2.0f*_1mt*t*(p0 + t*(p1-p0)) + t*t*(p1 -
-  // _1mt*v1);    // original function and its optimization
-  return _1mt * _1mt * (p0 + t * (2.0f * p0 + v0)) +
-         t * t * (p1 - _1mt * (2.0f * p1 - v1));
-}
-
 MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
 {
   ESS_PROFILE_SCOPE("AlembicPolyMeshNode::compute");
@@ -625,8 +652,9 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     ESS_PROFILE_SCOPE("AlembicPolyMeshNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -734,84 +762,21 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
   }
 
   if (samplePos->size() > 0) {
-    bool justCopyPoints = true;
-    points.setLength((unsigned int)samplePos->size());
-    const unsigned int il = points.length();
-
-    if (sampleInfo.alpha != 0.0) {
-      // if not dynamic topology or the faceCount/faceIndices remain the same,
-      // then proper interpolation is possible
-      if (!mDynamicTopology || !frameHasDynamicTopology(sample, sample2)) {
-        Abc::P3fArraySamplePtr samplePos2 = sample2.getPositions();
-
-        if (sampleVel != NULL) {
-          Abc::V3fArraySamplePtr sampleVel2 = sample2.getVelocities();
-          for (unsigned int i = 0; i < il; ++i) {
-            // blend with velocity
-            // ---> need the derivative to be the velocity
-
-            MFloatPoint &dstPoint = points[i];
-
-            const Abc::V3f &srcPos = samplePos->get()[i];
-            const Abc::V3f &srcPos2 = samplePos2->get()[i];
-
-            const Abc::V3f &srcVel = sampleVel->get()[i];
-            const Abc::V3f &srcVel2 = sampleVel2->get()[i];
-
-            dstPoint.x =
-                (float)C1Interpolation(srcPos.x, srcPos2.x, srcVel.x, srcVel2.x,
-                                       (float)sampleInfo.alpha);
-            dstPoint.y =
-                (float)C1Interpolation(srcPos.y, srcPos2.y, srcVel.y, srcVel2.y,
-                                       (float)sampleInfo.alpha);
-            dstPoint.z =
-                (float)C1Interpolation(srcPos.z, srcPos2.z, srcVel.z, srcVel2.z,
-                                       (float)sampleInfo.alpha);
-          }
-        }
-        else {
-          for (unsigned int i = 0; i < il; ++i) {
-            // blend points
-            MFloatPoint &dstPoint = points[i];
-
-            const Abc::V3f &srcPos = samplePos->get()[i];
-            const Abc::V3f &srcPos2 = samplePos2->get()[i];
-
-            dstPoint.x =
-                (float)(srcPos.x + sampleInfo.alpha * (srcPos2.x - srcPos.x));
-            dstPoint.y =
-                (float)(srcPos.y + sampleInfo.alpha * (srcPos2.y - srcPos.y));
-            dstPoint.z =
-                (float)(srcPos.z + sampleInfo.alpha * (srcPos2.z - srcPos.z));
-          }
-        }
-        justCopyPoints = false;
-      }
-      else if (sampleVel != NULL) {
-        // move points according to the velocity
-        for (unsigned int i = 0; i < il; ++i) {
-          MFloatPoint &dstPoint = points[i];
-          const Abc::V3f &srcPos = samplePos->get()[i];
-          const Abc::V3f &srcVel = sampleVel->get()[i];
-
-          dstPoint.x = (float)(srcPos.x + sampleInfo.alpha * srcVel.x);
-          dstPoint.y = (float)(srcPos.y + sampleInfo.alpha * srcVel.y);
-          dstPoint.z = (float)(srcPos.z + sampleInfo.alpha * srcVel.z);
-        }
-        justCopyPoints = false;
-      }
-    }
-
-    if (justCopyPoints) {
-      for (unsigned int i = 0; i < il; ++i) {
-        MFloatPoint &dstPoint = points[i];
-        const Abc::V3f &srcPoint = samplePos->get()[i];
-
-        dstPoint.x = srcPoint.x;
-        dstPoint.y = srcPoint.y;
-        dstPoint.z = srcPoint.z;
-      }
+    // if not dynamic topology or the faceCount/faceIndices remain the same,
+    // then proper interpolation is possible, otherwise the points are moved
+    // according to the velocity
+    const bool interpolate =
+        sampleInfo.alpha != 0.0 &&
+        (!mDynamicTopology || !frameHasDynamicTopology(sample, sample2));
+    Abc::P3fArraySamplePtr samplePos2;
+    Abc::V3fArraySamplePtr sampleVel2;
+    if (interpolate) {
+      samplePos2 = sample2.getPositions();
+      sampleVel2 = sample2.getVelocities();
     }
+    PointsInterpolator(samplePos, samplePos2, sampleVel, sampleVel2,
+                       (float)sampleInfo.alpha)
+        .compute(points);
   }
 
   // check if we already have the right polygons
@@ -838,8 +803,9 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
         mSampleLookup[smpIdx] = offset + j;
         indices[offset_j] = sampleIndices->get()[smpIdx];
 
+        // the normals are set in the alembic winding order
         mNormalFaces[offset_j] = i;
-        mNormalVertices[offset_j] = indices[offset_j];
+        mNormalVertices[offset_j] = sampleIndices->get()[offset_j];
       }
       offset += l_count;
     }
@@ -848,6 +814,7 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     mMesh.create(points.length(), counts.length(), points, counts, indices,
                  mMeshData);
     mMesh.updateSurface();
+    mNormalsApplied = false;
     if (mMesh.numFaceVertices() != indices.length()) {
       // EC_LOG_ERROR("Error: mesh topology has changed. Cannot import UVs or
       // normals.");
@@ -1006,11 +973,14 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     }
   }
   else if (mMesh.numVertices() == points.length()) {
+    // static topology, the faces, uvs and constant normals of the first build
+    // are kept and only the positions are written
+    ESS_PROFILE_SCOPE("AlembicPolyMeshNode::compute setPoints");
     mMesh.setPoints(points);
   }
 
-  // import the normals
-  if (importNormals) {
+  // import the normals, unless they are constant and already on the mesh
+  if (importNormals && !mNormalsApplied) {
     AbcG::IN3fGeomParam normalsParam = mSchema.getNormalsParam();
     if (normalsParam.valid()) {
       if (normalsParam.getNumSamples() > 0) {
@@ -1026,7 +996,7 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
         const bool normalCeil =
             !mDynamicTopology &&
             getIndexAndValues(sampleIndices, normalsParam,
-                              sampleInfo.floorIndex, normalValuesCeil,
+                              sampleInfo.ceilIndex, normalValuesCeil,
                               normalIndicesCeil);
 
         if (normalIndicesFloor.size() == mSampleLookup.size()) {
@@ -1058,38 +1028,21 @@ MStatus AlembicPolyMeshNode::compute(const MPlug &plug, MDataBlock &dataBlock)
             }
           }
 
-          MIntArray normalIndices((int)normalIndicesFloor.size());
-          for (int i = 0; i < (int)normalIndicesFloor.size(); i++) {
-            normalIndices[i] = normalIndicesFloor[mSampleLookup[i]];
-          }
-
           MVectorArray normalExpanded((int)normalIndicesFloor.size());
           for (int i = 0; i < (int)normalExpanded.length(); i++) {
             normalExpanded[i] = normals[normalIndicesFloor[i]];
           }
 
-          MIntArray faceList((int)normalIndicesFloor.size());
-          MIntArray vertexList((int)normalIndicesFloor.size());
-
-          MIntArray normalCounts((int)normalIndicesFloor.size());
-          int numFaces = mMesh.numPolygons();
-          int nIndex = 0;
-          for (int faceIndex = 0; faceIndex < numFaces; faceIndex++) {
-            MIntArray polyVerts;
-            mMesh.getPolygonVertices(faceIndex, polyVerts);
-            int numVertices = polyVerts.length();
-            for (int v = numVertices - 1; v >= 0; v--, ++nIndex) {
-              faceList[nIndex] = faceIndex;
-              vertexList[nIndex] = polyVerts[v];
-            }
-          }
-
           status =
-              mMesh.setFaceVertexNormals(normalExpanded, faceList, vertexList);
+              mMesh.setFaceVertexNormals(normalExpanded, mNormalFaces,
+                                         mNormalVertices);
           if (status != MS::kSuccess) {
             EC_LOG_ERROR("mMesh.setFaceVertexNormals - failed: "
                          << status.errorString().asChar());
           }
+          else {
+            mNormalsApplied = normalsParam.isConstant() && !mDynamicTopology;
+          }
         }
       }
     }
@@ -1140,6 +1093,8 @@ MStatus AlembicPolyMeshNode::setDependentsDirty(const MPlug &plugBeingDirtied,
 void AlembicPolyMeshDeformNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -1267,6 +1222,7 @@ MStatus AlembicPolyMeshDeformNode::deform(MDataBlock &dataBlock,
     }
     mSchema = obj.getSchema();
     cachePosition.clear();
+    mAbcPositions.clear();
 
     mDynamicTopology = pObjectCache->isMeshTopoDynamic;
   }
@@ -1279,8 +1235,9 @@ MStatus AlembicPolyMeshDeformNode::deform(MDataBlock &dataBlock,
     ESS_PROFILE_SCOPE("AlembicPolyMeshDeformNode::deform readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -1302,80 +1259,47 @@ MStatus AlembicPolyMeshDeformNode::deform(MDataBlock &dataBlock,
                                mSchema.getNumSamples());
   }
 
-  mLastSampleInfo = sampleInfo;
-
-  Abc::P3fArraySamplePtr samplePos;
-  Abc::P3fArraySamplePtr samplePos2;
-  {
-    // now using the cache to save the most recent queries!
-    ESS_PROFILE_SCOPE("AlembicPolyMeshDeformNode::deform get position samples");
-    if (cachePosition.contains(sampleInfo.floorIndex)) {
-      samplePos = cachePosition.get(sampleInfo.floorIndex);
-    }
-    else {
-      mSchema.getPositionsProperty().get(samplePos, sampleInfo.floorIndex);
-      cachePosition.insert(sampleInfo.floorIndex, samplePos);
-    }
-    if (sampleInfo.alpha != 0.0) {
-      if (cachePosition.contains(sampleInfo.ceilIndex)) {
-        samplePos2 = cachePosition.get(sampleInfo.ceilIndex);
+  // the blended positions are kept until another sample is needed, so a
+  // change of the envelope or of the weights only blends them again
+  if (mAbcPositions.length() == 0 ||
+      mLastSampleInfo.floorIndex != sampleInfo.floorIndex ||
+      mLastSampleInfo.ceilIndex != sampleInfo.ceilIndex ||
+      mLastSampleInfo.alpha != sampleInfo.alpha) {
+    Abc::P3fArraySamplePtr samplePos;
+    Abc::P3fArraySamplePtr samplePos2;
+    {
+      // now using the cache to save the most recent queries!
+      ESS_PROFILE_SCOPE(
+          "AlembicPolyMeshDeformNode::deform get position samples");
+      if (cachePosition.contains(sampleInfo.floorIndex)) {
+        samplePos = cachePosition.get(sampleInfo.floorIndex);
       }
       else {
-        mSchema.getPositionsProperty().get(samplePos2, sampleInfo.ceilIndex);
-        cachePosition.insert(sampleInfo.ceilIndex, samplePos2);
+        mSchema.getPositionsProperty().get(samplePos, sampleInfo.floorIndex);
+        cachePosition.insert(sampleInfo.floorIndex, samplePos);
+      }
+      if (sampleInfo.alpha != 0.0 && !mDynamicTopology) {
+        if (cachePosition.contains(sampleInfo.ceilIndex)) {
+          samplePos2 = cachePosition.get(sampleInfo.ceilIndex);
+        }
+        else {
+          mSchema.getPositionsProperty().get(samplePos2, sampleInfo.ceilIndex);
+          cachePosition.insert(sampleInfo.ceilIndex, samplePos2);
+        }
       }
     }
+
+    ESS_PROFILE_SCOPE("AlembicPolyMeshDeformNode::deform interpolate");
+    PointsInterpolator(samplePos, samplePos2, Abc::V3fArraySamplePtr(),
+                       Abc::V3fArraySamplePtr(), (float)sampleInfo.alpha)
+        .compute(mAbcPositions);
+    mLastSampleInfo = sampleInfo;
   }
 
   // iteration should not be necessary. the iteration is only
   // required if the same mesh is attached to the same deformer
   // several times
-  const float blend = (float)sampleInfo.alpha;
-  {
-    ESS_PROFILE_SCOPE("AlembicPolyMeshDeformNode::deform position iterator");
-
-    const bool useBlending = sampleInfo.alpha != 0.0 &&
-                             samplePos2->size() == samplePos->size() &&
-                             !mDynamicTopology;
-    for (iter.reset(); !iter.isDone(); iter.next()) {
-      const int iter_index = iter.index();
-      const float weight = weightValue(dataBlock, geomIndex, iter_index) * env;
-      if (weight == 0.0f) {
-        continue;
-      }
-      const float iweight = 1.0f - weight;
-
-      if (iter_index >= samplePos->size()) {
-        continue;
-      }
-      MPoint pt = iter.position();
-      if (iweight) {
-        pt.x *= iweight;
-        pt.y *= iweight;
-        pt.z *= iweight;
-      }
-      else {
-        pt.x = 0.0;
-        pt.y = 0.0;
-        pt.z = 0.0;
-      }
-
-      const Abc::V3f &pos1 = samplePos->get()[iter_index];
-      if (useBlending) {
-        const Abc::V3f &pos2 = samplePos2->get()[iter_index];
-        pt.x += weight * (pos1.x + (pos2.x - pos1.x) * blend);
-        pt.y += weight * (pos1.y + (pos2.y - pos1.y) * blend);
-        pt.z += weight * (pos1.z + (pos2.z - pos1.z) * blend);
-      }
-      else {
-        pt.x += weight * pos1.x;
-        pt.y += weight * pos1.y;
-        pt.z += weight * pos1.z;
-      }
-      iter.setPosition(pt);
-    }
-  }
-  return MStatus::kSuccess;
+  return blendPositions(dataBlock, iter, geomIndex, env, mAbcPositions);
 }
 
 // Cache the plug arrays for use in setDependentsDirty
@@ -3,6 +3,7 @@
 
 #include <maya/MFnMesh.h>
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 class AlembicPolyMesh : public AlembicObject {
@@ -14,7 +15,6 @@ class AlembicPolyMesh : public AlembicObject {
 
   AttributesWriterPtr mAttrs;
 
-  AbcG::OPolyMeshSchema::Sample mSample;
   std::vector<AbcG::OV2fGeomParam> mUvParams;
 
  public:
@@ -30,7 +30,9 @@ class AlembicPolyMesh : public AlembicObject {
 
 class AlembicPolyMeshNode : public AlembicObjectNode {
  public:
-  AlembicPolyMeshNode() : mUvFromDifferentFile(false) {}
+  AlembicPolyMeshNode() : mUvFromDifferentFile(false), mNormalsApplied(false)
+  {
+  }
   virtual ~AlembicPolyMeshNode();
 
   // override virtual methods from MPxNode
@@ -58,6 +60,8 @@ class AlembicPolyMeshNode : public AlembicObjectNode {
   MString mUvIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   Abc::IObject mObj;
   AbcG::IPolyMeshSchema mSchema;
   AbcG::IPolyMeshSchema mUvSchema;
@@ -79,6 +83,7 @@ class AlembicPolyMeshNode : public AlembicObjectNode {
   std::vector<unsigned int> mSampleLookup;
   MIntArray mNormalFaces;
   MIntArray mNormalVertices;
+  bool mNormalsApplied;  // constant normals already set on mMesh
 };
 
 class AlembicPolyMeshDeformNode : public AlembicObjectDeformNode {
@@ -111,6 +116,8 @@ class AlembicPolyMeshDeformNode : public AlembicObjectDeformNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   Abc::IObject mObj;
   AbcG::IPolyMeshSchema mSchema;
   bool mDynamicTopology;
@@ -122,6 +129,7 @@ class AlembicPolyMeshDeformNode : public AlembicObjectDeformNode {
   // members
   SampleInfo mLastSampleInfo;
   mruP3fArraySamplePtr cachePosition;
+  MPointArray mAbcPositions;  // blended positions of mLastSampleInfo
 };
 
 class AlembicCreateFaceSetsCommand : public MPxCommand {
@@ -2,6 +2,7 @@
 
 #include "AlembicSubD.h"
 #include "AttributesReading.h"
+#include "PointsInterpolation.h"
 #include "MetaData.h"
 
 AlembicSubD::AlembicSubD(SceneNodePtr eNode, AlembicWriteJob* in_Job,
@@ -235,6 +236,8 @@ MStatus AlembicSubD::Save(double time, unsigned int timeIndex,
 void AlembicSubDNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -382,8 +385,9 @@ MStatus AlembicSubDNode::compute(const MPlug& plug, MDataBlock& dataBlock)
     ESS_PROFILE_SCOPE("AlembicSubDNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
@@ -434,34 +438,10 @@ MStatus AlembicSubDNode::compute(const MPlug& plug, MDataBlock& dataBlock)
   }
 
   MPointArray points;
-  if (samplePos->size() > 0) {
-    points.setLength((unsigned int)samplePos->size());
-    bool done = false;
-    if (sampleInfo.alpha != 0.0) {
-      Abc::P3fArraySamplePtr samplePos2 = sample2.getPositions();
-      if (points.length() == (unsigned int)samplePos2->size()) {
-        float blend = (float)sampleInfo.alpha;
-        float iblend = 1.0f - blend;
-        for (unsigned int i = 0; i < points.length(); i++) {
-          points[i].x =
-              samplePos->get()[i].x * iblend + samplePos2->get()[i].x * blend;
-          points[i].y =
-              samplePos->get()[i].y * iblend + samplePos2->get()[i].y * blend;
-          points[i].z =
-              samplePos->get()[i].z * iblend + samplePos2->get()[i].z * blend;
-        }
-        done = true;
-      }
-    }
-
-    if (!done) {
-      for (unsigned int i = 0; i < points.length(); i++) {
-        points[i].x = samplePos->get()[i].x;
-        points[i].y = samplePos->get()[i].y;
-        points[i].z = samplePos->get()[i].z;
-      }
-    }
-  }
+  PointsInterpolator(samplePos, sample2.getPositions(),
+                     Abc::V3fArraySamplePtr(), Abc::V3fArraySamplePtr(),
+                     (float)sampleInfo.alpha)
+      .compute(points);
 
   MIntArray counts;
   MIntArray indices;
@@ -570,6 +550,8 @@ MStatus AlembicSubDNode::setDependentsDirty(const MPlug &plugBeingDirtied,
 void AlembicSubDDeformNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -730,8 +712,9 @@ MStatus AlembicSubDDeformNode::deform(MDataBlock& dataBlock, MItGeometry& iter,
     ESS_PROFILE_SCOPE("AlembicSubDDeformNode::deform readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
 
     // Set all plugs as clean
     // Even if one of them failed to get set,
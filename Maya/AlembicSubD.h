@@ -4,6 +4,7 @@
 #include <maya/MFnSubd.h>
 #include <maya/MUint64Array.h>
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 class AlembicSubD : public AlembicObject {
@@ -58,6 +59,8 @@ class AlembicSubDNode : public AlembicObjectNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::ISubDSchema mSchema;
   static MObject mUvsAttr;
 
@@ -101,6 +104,8 @@ class AlembicSubDDeformNode : public AlembicObjectDeformNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::ISubDSchema mSchema;
   std::vector<unsigned int> mVertexLookup;
 
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 
+#include <boost/bind.hpp>
 #include <sstream>
 
 #include "AlembicWriteJob.h"
@@ -29,6 +30,145 @@ struct PreProcessStackElement {
   }
 };
 
+AlembicSampleWriter::AlembicSampleWriter() : mThreaded(false), mStop(false)
+{
+}
+
+void AlembicSampleWriter::queue(const AlembicSamplePacketPtr &packet)
+{
+  mQueued.push_back(packet);
+}
+
+void AlembicSampleWriter::convertPackets(size_t first, size_t stride,
+                                         std::string *error)
+{
+  try {
+    for (size_t i = first; i < mWriting.size(); i += stride) {
+      mWriting[i]->convert();
+    }
+  }
+  catch (std::exception &e) {
+    *error = e.what();
+  }
+  catch (...) {
+    *error = "unknown error while converting the samples";
+  }
+}
+
+// the writer thread must not log, that goes through Maya
+void AlembicSampleWriter::writePackets()
+{
+  ESS_PROFILE_SCOPE("AlembicSampleWriter::writePackets");
+
+  // the packets of a frame are spread over the threads, an archive can only
+  // be written by one thread at a time
+  const size_t nbThreads =
+      std::min(mWriting.size(),
+               (size_t)std::max(1u, boost::thread::hardware_concurrency()));
+  std::vector<std::string> errors(nbThreads);
+  if (nbThreads > 1) {
+    boost::thread_group threads;
+    for (size_t t = 0; t < nbThreads; ++t) {
+      threads.create_thread(boost::bind(&AlembicSampleWriter::convertPackets,
+                                        this, t, nbThreads, &errors[t]));
+    }
+    threads.join_all();
+  }
+  else if (nbThreads == 1) {
+    convertPackets(0, 1, &errors[0]);
+  }
+
+  std::string error;
+  for (size_t t = 0; t < nbThreads && error.empty(); ++t) {
+    error = errors[t];
+  }
+  try {
+    for (size_t i = 0; i < mWriting.size() && error.empty(); ++i) {
+      mWriting[i]->write();
+    }
+  }
+  catch (std::exception &e) {
+    error = e.what();
+  }
+  catch (...) {
+    error = "unknown error while writing the samples";
+  }
+
+  boost::mutex::scoped_lock lock(mMutex);
+  if (mError.empty()) {
+    mError = error;
+  }
+  mWriting.clear();
+  mCondition.notify_all();
+}
+
+void AlembicSampleWriter::run()
+{
+  for (;;) {
+    {
+      boost::mutex::scoped_lock lock(mMutex);
+      while (!mStop && mWriting.empty()) {
+        mCondition.wait(lock);
+      }
+      if (mStop) {
+        return;
+      }
+    }
+    writePackets();
+  }
+}
+
+void AlembicSampleWriter::submit()
+{
+  std::string error;
+  flush(error);
+  if (mQueued.empty()) {
+    return;
+  }
+
+  if (!mThreaded) {
+    mWriting.swap(mQueued);
+    writePackets();
+    return;
+  }
+
+  {
+    boost::mutex::scoped_lock lock(mMutex);
+    mWriting.swap(mQueued);
+    if (mThread.get_id() == boost::thread::id()) {
+      mStop = false;
+      mThread = boost::thread(boost::bind(&AlembicSampleWriter::run, this));
+    }
+  }
+  mCondition.notify_all();
+}
+
+bool AlembicSampleWriter::flush(std::string &error)
+{
+  boost::mutex::scoped_lock lock(mMutex);
+  while (!mWriting.empty()) {
+    mCondition.wait(lock);
+  }
+  error = mError;
+  return mError.empty();
+}
+
+void AlembicSampleWriter::stop()
+{
+  {
+    boost::mutex::scoped_lock lock(mMutex);
+    mStop = true;
+  }
+  mCondition.notify_all();
+  if (mThread.joinable()) {
+    mThread.join();
+  }
+  mThread = boost::thread();
+  mQueued.clear();
+  mWriting.clear();
+  mStop = false;
+}
+
 AlembicWriteJob::AlembicWriteJob(const MString &in_FileName,
                                  const MObjectArray &in_Selection,
                                  const MDoubleArray &in_Frames, bool use_ogawa,
@@ -55,7 +195,7 @@ AlembicWriteJob::AlembicWriteJob(const MString &in_FileName,
   }
 }
 
-AlembicWriteJob::~AlembicWriteJob() {}
+AlembicWriteJob::~AlembicWriteJob() { mWriter.stop(); }
 void AlembicWriteJob::SetOption(const MString &in_Name, const MString &in_Value)
 {
   ESS_PROFILE_SCOPE("AlembicWriteJob::SetOption");
@@ -126,6 +266,10 @@ void AlembicWriteJob::createArchive(const char *sceneFileName)
         Alembic::AbcCoreHDF5::WriteArchive(true), mFileName.asChar(),
         expName.c_str(), expFileName.c_str(), Abc::ErrorHandler::kThrowPolicy);
   }
+
+  // HDF5 is not thread safe and the scene can read other HDF5 archives while
+  // the samples are written
+  mWriter.setThreaded(useOgawa);
 }
 
 MStatus AlembicWriteJob::PreProcess()
@@ -350,13 +494,18 @@ MStatus AlembicWriteJob::Process(double frame)
     return MS::kSuccess;
   }
 
+  // the objects write to the archive too, the previous frame must be done
+  MStatus status = FlushSamples();
+  if (status != MStatus::kSuccess) {
+    return status;
+  }
+
   // run the export for all objects
   MayaProgressBar pBar;
   pBar.init(0, (int)mapObjects.size(), 1);
   pBar.start();
 
   int interrupt = 20;
-  MStatus status;
   const double currentFrame = mFrames[i];
   const bool isFirstFrame = (i == 0);
 
@@ -377,11 +526,26 @@ MStatus AlembicWriteJob::Process(double frame)
     }
   }
   pBar.stop();
+
+  // written while Maya evaluates the next frame
+  mWriter.submit();
   return status;
 }
 
+MStatus AlembicWriteJob::FlushSamples()
+{
+  std::string error;
+  if (!mWriter.flush(error)) {
+    MPxCommand::setResult("Error caught in AlembicWriteJob::Process: " +
+                          MString(error.c_str()));
+    return MS::kFailure;
+  }
+  return MS::kSuccess;
+}
+
 bool AlembicWriteJob::forceCloseArchive(void)
 {
+  mWriter.stop();
   if (mArchive.valid()) {
     mArchive.reset();
   }
@@ -816,8 +980,26 @@ MStatus AlembicExportCommand::doIt(const MArgList &args)
           return status;
         }
       }
+
+      // the merged curves are written from this thread, so the samples of
+      // the frame must be in the archives first, a failure is reported by
+      // the last flush
+      if (AlembicCurveAccumulator::HasAccumulators()) {
+        for (size_t i = 0; i < jobPtrs.size(); i++) {
+          jobPtrs[i]->FlushSamples();
+        }
+      }
       AlembicCurveAccumulator::StopRecordingFrame();
     }
+
+    // the samples of the last frame are still being written
+    for (size_t i = 0; i < jobPtrs.size(); i++) {
+      if (jobPtrs[i]->FlushSamples() != MStatus::kSuccess) {
+        MGlobal::displayError("[ExocortexAlembic] Job aborted :" +
+                              jobPtrs[i]->GetFileName());
+        status = MS::kFailure;
+      }
+    }
   }
   catch (...) {
     MGlobal::displayError(
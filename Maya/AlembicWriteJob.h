@@ -3,6 +3,8 @@
 
 #include <set>
 
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/thread.hpp>
 #include "AlembicObject.h"
 
 #include "CommonRegex.h"
@@ -10,6 +12,42 @@
 typedef std::pair<std::string, AlembicObjectPtr> pairStrAbcObj;
 typedef std::multimap<std::string, AlembicObjectPtr> multiMapStrAbcObj;
 
+// Stores the sample packets of a frame in the archive from a background
+// thread, while Maya evaluates the next frame. A single frame is in flight:
+// the packets are queued during the frame, then submitted at its end. The
+// packets are converted on all the cores before being written one by one.
+class AlembicSampleWriter {
+ public:
+  AlembicSampleWriter();
+  ~AlembicSampleWriter() { stop(); }
+
+  // without a thread, the packets are written when they are submitted
+  void setThreaded(bool threaded) { mThreaded = threaded; }
+  void queue(const AlembicSamplePacketPtr& packet);
+  void submit();
+
+  // waits for the submitted packets, returns false with the error of the
+  // first packet which failed
+  bool flush(std::string& error);
+
+  // stops the thread, the packets not written yet are dropped
+  void stop();
+
+ private:
+  void run();
+  void writePackets();
+  void convertPackets(size_t first, size_t stride, std::string* error);
+
+  std::vector<AlembicSamplePacketPtr> mQueued;
+  std::vector<AlembicSamplePacketPtr> mWriting;
+  std::string mError;
+  boost::thread mThread;
+  boost::mutex mMutex;
+  boost::condition_variable mCondition;
+  bool mThreaded;
+  bool mStop;
+};
+
 class AlembicWriteJob {
  private:
   MString mFileName;
@@ -27,6 +65,7 @@ class AlembicWriteJob {
 
   multiMapStrAbcObj mapObjects;
   double mFrameRate;
+  AlembicSampleWriter mWriter;
 
   void createArchive(
       const char* sceneFileName);  // initialize mArchive with HDF5 or Ogawa!
@@ -61,6 +100,14 @@ class AlembicWriteJob {
   size_t GetNbObjects() { return mapObjects.size(); }
   MStatus PreProcess();
   MStatus Process(double frame);
+
+  // the packet is written once all the objects of the frame are saved
+  void QueueSample(const AlembicSamplePacketPtr& packet)
+  {
+    mWriter.queue(packet);
+  }
+  // waits until the samples of the previous frames are in the archive
+  MStatus FlushSamples();
   bool forceCloseArchive(void);
 };
 
@@ -195,6 +195,8 @@ MStatus AlembicXform::Save(double time, unsigned int timeIndex,
 void AlembicXformNode::PreDestruction()
 {
   mSchema.reset();
+  mArbPropsCache.clear();
+  mUserPropsCache.clear();
   delRefArchive(mFileName);
   mFileName.clear();
 }
@@ -499,8 +501,9 @@ MStatus AlembicXformNode::compute(const MPlug &plug, MDataBlock &dataBlock)
     ESS_PROFILE_SCOPE("AlembicXformNode::compute readProps");
     Alembic::Abc::ICompoundProperty arbProp = mSchema.getArbGeomParams();
     Alembic::Abc::ICompoundProperty userProp = mSchema.getUserProperties();
-    readProps(inputTime, arbProp, dataBlock, thisMObject());
-    readProps(inputTime, userProp, dataBlock, thisMObject());
+    readProps(inputTime, arbProp, dataBlock, thisMObject(), &mArbPropsCache);
+    readProps(inputTime, userProp, dataBlock, thisMObject(),
+              &mUserPropsCache);
   }
 
   SampleInfo sampleInfo = getSampleInfo(inputTime, mSchema.getTimeSampling(),
@@ -2,6 +2,7 @@
 #define _ALEMBIC_XFORM_H_
 
 #include "AlembicObject.h"
+#include "AttributesReading.h"
 #include "AttributesWriter.h"
 
 enum VISIBILITY_TYPE { VISIBLE, NOT_VISIBLE, ANIMATED_VISIBLE };
@@ -64,6 +65,8 @@ class AlembicXformNode : public AlembicObjectNode {
   MString mIdentifier;
   MPlugArray mGeomParamPlugs;
   MPlugArray mUserAttrPlugs;
+  ReadPropsCache mArbPropsCache;
+  ReadPropsCache mUserPropsCache;
   AbcG::IXformSchema mSchema;
   std::map<AbcA::index_t, Abc::M44d> mSampleIndicesToMatrices;
   Abc::M44d mLastMatrix;
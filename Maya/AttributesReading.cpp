@@ -2495,15 +2495,22 @@ void readProp(double iFrame,
 }
 
 void readProps(double iFrame,
-              Alembic::Abc::ICompoundProperty & iParent,
-              MDataBlock & iDataBlock,
-              const MObject & iNode)
+               Alembic::Abc::ICompoundProperty & iParent,
+               MDataBlock & iDataBlock,
+               const MObject & iNode,
+               ReadPropsCache * iCache)
 {
     // if the params CompoundProperty (.arbGeomParam or .userProperties)
     // aren't valid, then skip
     if (!iParent)
         return;
 
+    if (iCache != NULL && iCache->mParent != iParent.getPtr().get())
+    {
+        iCache->clear();
+        iCache->mParent = iParent.getPtr().get();
+    }
+
     MStatus status;
     MFnDependencyNode depNode(iNode, &status);
     if (status != MStatus::kSuccess) {
@@ -2533,6 +2540,56 @@ void readProps(double iFrame,
           continue;
         }
 
+        // skip the properties whose plug already holds the right sample
+        ReadPropsCache::Entry * entry = NULL;
+        SampleInfo sampleInfo = {0, 0, 0.0};
+        if (iCache != NULL)
+        {
+            entry = &iCache->mEntries[propName];
+            if (!entry->mProp.mArray.valid() &&
+                !entry->mProp.mScalar.valid())
+            {
+                if (propHeader.isArray())
+                {
+                    entry->mProp.mArray =
+                        Alembic::Abc::IArrayProperty(iParent, propName);
+                    entry->mConstant = entry->mProp.mArray.isConstant();
+                }
+                else if (propHeader.isScalar())
+                {
+                    entry->mProp.mScalar =
+                        Alembic::Abc::IScalarProperty(iParent, propName);
+                    entry->mConstant = entry->mProp.mScalar.isConstant();
+                }
+            }
+
+            if (entry->mProp.mArray.valid())
+            {
+                sampleInfo = getSampleInfo(iFrame,
+                    entry->mProp.mArray.getTimeSampling(),
+                    entry->mProp.mArray.getNumSamples());
+            }
+            else if (entry->mProp.mScalar.valid())
+            {
+                sampleInfo = getSampleInfo(iFrame,
+                    entry->mProp.mScalar.getTimeSampling(),
+                    entry->mProp.mScalar.getNumSamples());
+            }
+            else
+            {
+                // nothing readProp can read
+                continue;
+            }
+
+            if (entry->mRead && (entry->mConstant ||
+                (entry->mFloorIndex == sampleInfo.floorIndex &&
+                 entry->mCeilIndex == sampleInfo.ceilIndex &&
+                 entry->mAlpha == sampleInfo.alpha)))
+            {
+                continue;
+            }
+        }
+
         MPlug plug = depNode.findPlug(propName.c_str(), true, &status);
         if (status != MStatus::kSuccess) {
             MGlobal::displayWarning("Skipping new property " + depNode.name() + "." + MString(propName.c_str()));
@@ -2547,7 +2604,9 @@ void readProps(double iFrame,
 
         if (propHeader.isArray())
         {
-            Alembic::Abc::IArrayProperty prop(iParent, propName);
+            Alembic::Abc::IArrayProperty prop = entry != NULL ?
+                entry->mProp.mArray :
+                Alembic::Abc::IArrayProperty(iParent, propName);
             if (prop.getNumSamples() == 0)
             {
                 MString warn = "Skipping property with no samples: ";
@@ -2560,7 +2619,9 @@ void readProps(double iFrame,
         }
         else if (propHeader.isScalar())
         {
-            Alembic::Abc::IScalarProperty prop(iParent, propName);
+            Alembic::Abc::IScalarProperty prop = entry != NULL ?
+                entry->mProp.mScalar :
+                Alembic::Abc::IScalarProperty(iParent, propName);
             if (prop.getNumSamples() == 0)
             {
                 MString warn = "Skipping property with no samples: ";
@@ -2571,5 +2632,13 @@ void readProps(double iFrame,
 
             readProp(iFrame, prop, handle);
         }
+
+        if (entry != NULL)
+        {
+            entry->mRead = true;
+            entry->mFloorIndex = sampleInfo.floorIndex;
+            entry->mCeilIndex = sampleInfo.ceilIndex;
+            entry->mAlpha = sampleInfo.alpha;
+        }
     }
 }
@@ -57,6 +57,7 @@
 #include <maya/MFnNumericAttribute.h>
 #include <maya/MFnNumericData.h>
 
+#include <map>
 #include <vector>
 #include <string>
 
@@ -140,9 +141,36 @@ void readProp(double iFrame,
               Alembic::Abc::IScalarProperty & iProp,
               MDataHandle & iHandle);
 
+// What readProps last wrote for the properties of one compound, so the
+// constant properties and those whose sample did not change are neither read
+// nor written again. A node keeps one per compound it reads.
+struct ReadPropsCache
+{
+    struct Entry
+    {
+        Entry() : mConstant(false), mRead(false), mFloorIndex(0),
+            mCeilIndex(0), mAlpha(0.0) {}
+
+        Prop mProp;
+        bool mConstant;
+        bool mRead;
+        Alembic::AbcCoreAbstract::index_t mFloorIndex;
+        Alembic::AbcCoreAbstract::index_t mCeilIndex;
+        double mAlpha;
+    };
+
+    ReadPropsCache() : mParent(NULL) {}
+    void clear() { mParent = NULL; mEntries.clear(); }
+
+    // the compound the entries were made for
+    const void * mParent;
+    std::map<std::string, Entry> mEntries;
+};
+
 void readProps(double iFrame,
                Alembic::Abc::ICompoundProperty & iParent,
                MDataBlock & iDataBlock,
-               const MObject & iNode);
+               const MObject & iNode,
+               ReadPropsCache * iCache = NULL);
 
 #endif  // ABCIMPORT_NODE_ITERATOR_HELPER_H_
@@ -1,4 +1,3 @@
-import maya.mel as mel
 import maya.cmds as cmds
 
 """ Contains functions and data structures """
@@ -127,43 +126,3 @@ def alembicPolyMeshToSubdiv(mesh=None):
 	except Exception as ex:
 		return str(ex.args)
 	return ""
-
-############################################################################################################
-# progress bar
-############################################################################################################
-
-__gMainProgressBar = ""
-
-def progressBar_init(_max):
-	global __gMainProgressBar
-	try:
-		__gMainProgressBar = mel.eval('$tmp = $gMainProgressBar')
-		if __gMainProgressBar != "":
-			cmds.progressBar(__gMainProgressBar, edit=True, isInterruptable=True, maxValue=_max)
-	except:
-		__gMainProgressBar = ""
-
-def progressBar_start():
-	global __gMainProgressBar
-	if __gMainProgressBar != "":
-		cmds.progressBar(__gMainProgressBar, edit=True, beginProgress=True, step=1)
-
-def progressBar_stop():
-	global __gMainProgressBar
-	if __gMainProgressBar != "":
-		cmds.progressBar(__gMainProgressBar, edit=True, endProgress=True)
-
-def progressBar_incr(_step=20):
-	global __gMainProgressBar
-	if __gMainProgressBar != "":
-		cmds.progressBar(__gMainProgressBar, edit=True, step=_step)
-
-def progressBar_isCancelled():
-	global __gMainProgressBar
-	if __gMainProgressBar == "":
-		return 0
-	if cmds.progressBar(__gMainProgressBar, query=True, isCancelled=True):
-		return 1
-	return 0
-
-
@@ -0,0 +1,222 @@
+#include "stdafx.h"
+
+#include "PointsInterpolation.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+// below that amount of points, the tasks cost more than they save
+static const size_t gParallelPointsThreshold = 1 << 16;
+
+// points interpolated by a single task
+static const size_t gParallelPointsGrain = 1 << 14;
+
+// points interpolated at once in a stack buffer before being converted
+static const size_t gPointsBlockSize = 256;
+
+float C1Interpolation(float p0, float p1, float v0, float v1, float t)
+{
+  const float _1mt = 1.0f - t;
+  // return _1mt*_1mt*(p0 + t*v0) + 2.0f*_1mt*t*(p0 + t*(p1-p0)) + t*t*(p1 -
+  // _1mt*v1);    // original function and its optimization
+  return _1mt * _1mt * (p0 + t * (2.0f * p0 + v0)) +
+         t * t * (p1 - _1mt * (2.0f * p1 - v1));
+}
+
+static inline void storePoint(MFloatPoint &dst, const float *src)
+{
+  dst.x = src[0];
+  dst.y = src[1];
+  dst.z = src[2];
+  dst.w = 1.0f;
+}
+
+static inline void storePoint(MPoint &dst, const float *src)
+{
+  dst.x = src[0];
+  dst.y = src[1];
+  dst.z = src[2];
+  dst.w = 1.0;
+}
+
+static inline void storePoint(MVector &dst, const float *src)
+{
+  dst.x = src[0];
+  dst.y = src[1];
+  dst.z = src[2];
+}
+
+PointsInterpolator::PointsInterpolator(const Abc::P3fArraySamplePtr &pos,
+                                       const Abc::P3fArraySamplePtr &pos2,
+                                       const Abc::V3fArraySamplePtr &vel,
+                                       const Abc::V3fArraySamplePtr &vel2,
+                                       float alpha)
+    : mMode(COPY),
+      mCount(pos ? pos->size() : 0),
+      mAlpha(alpha),
+      mPos(mCount ? (const float *)pos->get() : NULL),
+      mPos2(NULL),
+      mVel(NULL),
+      mVel2(NULL),
+      mSingleVel(false)
+{
+  if (mCount == 0 || alpha == 0.0f) {
+    return;
+  }
+
+  const bool validVel = vel && (vel->size() == mCount || vel->size() == 1);
+  if (pos2 && pos2->size() == mCount) {
+    mPos2 = (const float *)pos2->get();
+    mMode = LERP;
+    if (validVel && vel->size() == mCount && vel2 &&
+        vel2->size() == mCount) {
+      mVel = (const float *)vel->get();
+      mVel2 = (const float *)vel2->get();
+      mMode = C1;
+    }
+  }
+  else if (validVel) {
+    mVel = (const float *)vel->get();
+    mSingleVel = (vel->size() == 1);
+    mMode = EXTRAPOLATE;
+  }
+}
+
+void PointsInterpolator::computeRange(float *dst, size_t begin,
+                                      size_t end) const
+{
+  const size_t first = begin * 3, last = end * 3;
+  const float t = mAlpha;
+  const float *p0 = mPos, *p1 = mPos2, *v0 = mVel, *v1 = mVel2;
+  switch (mMode) {
+    case COPY:
+      std::copy(p0 + first, p0 + last, dst);
+      break;
+    case LERP:
+      for (size_t i = first; i < last; ++i) {
+        *dst++ = p0[i] + (p1[i] - p0[i]) * t;
+      }
+      break;
+    case C1:
+      for (size_t i = first; i < last; ++i) {
+        *dst++ = C1Interpolation(p0[i], p1[i], v0[i], v1[i], t);
+      }
+      break;
+    case EXTRAPOLATE:
+      if (mSingleVel) {
+        const float vx = v0[0] * t, vy = v0[1] * t, vz = v0[2] * t;
+        for (size_t i = first; i < last; i += 3) {
+          *dst++ = p0[i] + vx;
+          *dst++ = p0[i + 1] + vy;
+          *dst++ = p0[i + 2] + vz;
+        }
+      }
+      else {
+        for (size_t i = first; i < last; ++i) {
+          *dst++ = p0[i] + v0[i] * t;
+        }
+      }
+      break;
+  }
+}
+
+// the points are interpolated a block at a time in a flat buffer, then
+// converted to the Maya type
+template <class T>
+void PointsInterpolator::computeBlocks(T *dst, size_t begin, size_t end) const
+{
+  float buffer[gPointsBlockSize * 3];
+  for (size_t block = begin; block < end; block += gPointsBlockSize) {
+    const size_t blockEnd = std::min(block + gPointsBlockSize, end);
+    computeRange(buffer, block, blockEnd);
+    T *out = dst + (block - begin);
+    for (size_t i = 0; i < blockEnd - block; ++i) {
+      storePoint(out[i], buffer + i * 3);
+    }
+  }
+}
+
+// Abc::V3f has the flat layout of the kernels, no conversion needed
+template <>
+void PointsInterpolator::computeBlocks(Abc::V3f *dst, size_t begin,
+                                       size_t end) const
+{
+  computeRange((float *)dst, begin, end);
+}
+
+// the tbb task of a range of points
+template <class T>
+struct PointsInterpolator::BlocksTask {
+  const PointsInterpolator *interpolator;
+  T *dst;
+  size_t begin;
+
+  void operator()(const tbb::blocked_range<size_t> &range) const
+  {
+    interpolator->computeBlocks(dst + range.begin(), begin + range.begin(),
+                                begin + range.end());
+  }
+};
+
+// the large arrays are split with tbb, which shares Maya's worker threads
+// with the other nodes evaluated in parallel
+template <class T>
+void PointsInterpolator::computeInto(T *dst, size_t begin, size_t count) const
+{
+  if (count < gParallelPointsThreshold) {
+    computeBlocks(dst, begin, begin + count);
+    return;
+  }
+
+  BlocksTask<T> task = {this, dst, begin};
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, count, gParallelPointsGrain), task);
+}
+
+static size_t clampCount(size_t total, size_t begin, size_t count)
+{
+  if (begin >= total) {
+    return 0;
+  }
+  return std::min(count, total - begin);
+}
+
+void PointsInterpolator::compute(MFloatPointArray &out, size_t begin,
+                                 size_t count) const
+{
+  count = clampCount(mCount, begin, count);
+  out.setLength((unsigned int)count);
+  if (count > 0) {
+    computeInto(&out[0], begin, count);
+  }
+}
+
+void PointsInterpolator::compute(MPointArray &out, size_t begin,
+                                 size_t count) const
+{
+  count = clampCount(mCount, begin, count);
+  out.setLength((unsigned int)count);
+  if (count > 0) {
+    computeInto(&out[0], begin, count);
+  }
+}
+
+void PointsInterpolator::compute(MVectorArray &out, size_t begin,
+                                 size_t count) const
+{
+  count = clampCount(mCount, begin, count);
+  out.setLength((unsigned int)count);
+  if (count > 0) {
+    computeInto(&out[0], begin, count);
+  }
+}
+
+void PointsInterpolator::compute(std::vector<Abc::V3f> &out, size_t begin,
+                                 size_t count) const
+{
+  count = clampCount(mCount, begin, count);
+  out.resize(count);
+  if (count > 0) {
+    computeInto(&out[0], begin, count);
+  }
+}
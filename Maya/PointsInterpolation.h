@@ -0,0 +1,62 @@
+#ifndef _POINTS_INTERPOLATION_H_
+#define _POINTS_INTERPOLATION_H_
+
+/**
+ * Position interpolation shared by the geometry nodes.
+ *
+ * The blend between the floor and the ceil samples is chosen once from the
+ * samples that are given: C1 interpolation when both samples have
+ * velocities, linear interpolation, extrapolation along the velocities of the
+ * floor sample, or a plain copy. The kernels work on the flat float arrays of
+ * the samples so the compiler can vectorize them, and large arrays are split
+ * into tbb tasks. The results are written straight into the Maya arrays.
+ */
+class PointsInterpolator {
+ public:
+  enum Mode { COPY, LERP, C1, EXTRAPOLATE };
+
+  // pos2 and vel2 are only used when they have as many values as pos, vel can
+  // hold a single value shared by all the points
+  PointsInterpolator(const Abc::P3fArraySamplePtr &pos,
+                     const Abc::P3fArraySamplePtr &pos2,
+                     const Abc::V3fArraySamplePtr &vel,
+                     const Abc::V3fArraySamplePtr &vel2, float alpha);
+
+  Mode getMode() const { return mMode; }
+  size_t size() const { return mCount; }
+
+  // resizes out to count points and fills it with the points
+  // [begin, begin + count) of the samples, count defaults to all the points
+  void compute(MFloatPointArray &out, size_t begin = 0,
+               size_t count = (size_t)-1) const;
+  void compute(MPointArray &out, size_t begin = 0,
+               size_t count = (size_t)-1) const;
+  void compute(MVectorArray &out, size_t begin = 0,
+               size_t count = (size_t)-1) const;
+  void compute(std::vector<Abc::V3f> &out, size_t begin = 0,
+               size_t count = (size_t)-1) const;
+
+  // fills dst, 3 floats per point, with the points [begin, end)
+  void computeRange(float *dst, size_t begin, size_t end) const;
+
+ private:
+  template <class T>
+  void computeInto(T *dst, size_t begin, size_t count) const;
+  template <class T>
+  void computeBlocks(T *dst, size_t begin, size_t end) const;
+  template <class T>
+  struct BlocksTask;
+
+  Mode mMode;
+  size_t mCount;
+  float mAlpha;
+  const float *mPos;
+  const float *mPos2;
+  const float *mVel;
+  const float *mVel2;
+  bool mSingleVel;
+};
+
+float C1Interpolation(float p0, float p1, float v0, float v1, float t);
+
+#endif
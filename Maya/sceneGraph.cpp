@@ -6,6 +6,7 @@
 #include "CommonLog.h"
 
 #include <maya/MDGModifier.h>
+#include <maya/MDagModifier.h>
 #include <maya/MFnDagNode.h>
 #include <maya/MItDag.h>
 
@@ -58,7 +59,15 @@ AlembicFileAndTimeControlPtr AlembicFileAndTimeControl::createControl(
     __file_and_time_control_kill(var);
     return AlembicFileAndTimeControlPtr();
   }
-  return AlembicFileAndTimeControlPtr(new AlembicFileAndTimeControl(var));
+
+  // the nodes are also kept for the nodes created with the API
+  AlembicFileAndTimeControlPtr control(new AlembicFileAndTimeControl(var));
+  MString fileNode, timeControl;
+  MGlobal::executePythonCommand(var + ".filenode", fileNode);
+  MGlobal::executePythonCommand(var + ".timeCtrl", timeControl);
+  control->fileNodeObj = findMObjectByName(fileNode);
+  control->timeControlObj = findMObjectByName(timeControl);
+  return control;
 }
 
 bool SceneNodeMaya::replaceData(SceneNodeAlembicPtr fileNode,
@@ -97,7 +106,7 @@ bool SceneNodeMaya::replaceData(SceneNodeAlembicPtr fileNode,
 }
 
 bool SceneNodeMaya::connectProps(MFnDependencyNode &depNode,
-    MFnDependencyNode &readerDepNode)
+    MFnDependencyNode &readerDepNode, MDGModifier &mod)
 {
   MStatus status;
   MPlug geomParamsPlug = readerDepNode.findPlug("ExocortexAlembic_GeomParams",
@@ -121,7 +130,6 @@ bool SceneNodeMaya::connectProps(MFnDependencyNode &depNode,
   MStringArray userProps;
   userProp.split(';', userProps);
 
-  MDGModifier mod;
   for (unsigned int i = 0; i < geomProps.length(); i++) {
     MStatus propStatus;
     MPlug readerPlug = readerDepNode.findPlug(geomProps[i], &propStatus);
@@ -140,9 +148,7 @@ bool SceneNodeMaya::connectProps(MFnDependencyNode &depNode,
     }
   }
 
-  status = mod.doIt();
-
-  return (status == MStatus::kSuccess);
+  return true;
 }
 
 bool SceneNodeMaya::removeProps(const MString &dccReaderIdentifier)
@@ -222,6 +228,250 @@ bool SceneNodeMaya::executeAddChild(const MString &cmd,
   return true;
 }
 
+static MString melString(const std::string &str)
+{
+  std::string result("\"");
+  for (size_t i = 0; i < str.size(); ++i) {
+    if (str[i] == '\\' || str[i] == '"') {
+      result += '\\';
+    }
+    result += str[i];
+  }
+  result += "\"";
+  return result.c_str();
+}
+
+// the Python functions handle the names with namespaces or paths, and the
+// shapes without a parent transform
+bool SceneNodeMaya::canCreateNode(SceneNodeAlembicPtr fileNode,
+                                  bool needsParent) const
+{
+  if (fileAndTime->fileNode().isNull() ||
+      fileAndTime->timeControl().isNull() ||
+      fileNode->name.find_first_of(":|") != std::string::npos) {
+    return false;
+  }
+  return !needsParent || ((type == ETRANSFORM || type == ITRANSFORM) &&
+                          (!nodeObj.isNull() || !dccIdentifier.empty()));
+}
+
+// setupReaderAttribute of _import.py, except for the identifier which is set
+// once the connections are made
+bool SceneNodeMaya::connectReader(MDGModifier &mod,
+                                  MFnDependencyNode &readerDepNode,
+                                  bool connectTime)
+{
+  MStatus status;
+  MFnDependencyNode fileDepNode(fileAndTime->fileNode());
+  if (connectTime) {
+    MFnDependencyNode timeDepNode(fileAndTime->timeControl());
+    status = mod.connect(timeDepNode.findPlug("outTime", true),
+                         readerDepNode.findPlug("inTime", true));
+    if (status != MS::kSuccess) {
+      return false;
+    }
+  }
+  status = mod.connect(fileDepNode.findPlug("outFileName", true),
+                       readerDepNode.findPlug("fileName", true));
+  return status == MS::kSuccess;
+}
+
+bool SceneNodeMaya::createXformNode(SceneNodeAlembicPtr fileNode,
+                                    SceneNodeAppPtr &newAppNode)
+{
+  ESS_PROFILE_SCOPE("SceneNodeMaya::createXformNode");
+  MStatus status;
+  MObject parent;
+  if (type == ETRANSFORM || type == ITRANSFORM) {
+    parent = nodeObj.isNull() ? findMObjectByName(dccIdentifier.c_str())
+                              : nodeObj;
+  }
+
+  if (!fileAndTime->pendingMod) {
+    fileAndTime->pendingMod.reset(new MDagModifier());
+  }
+  MDagModifier &dagMod = *fileAndTime->pendingMod;
+  PendingMayaNode pending;
+  pending.node = dagMod.createNode("transform", parent, &status);
+  if (status != MS::kSuccess) {
+    return false;
+  }
+  dagMod.renameNode(pending.node, fileNode->name.c_str());
+  pending.reader =
+      dagMod.MDGModifier::createNode("ExocortexAlembicXform", &status);
+  if (status != MS::kSuccess) {
+    return false;
+  }
+
+  pending.appNode = newAppNode;
+  pending.fileNode = fileNode;
+  pending.isMesh = false;
+  fileAndTime->pendingNodes.push_back(pending);
+  static_cast<SceneNodeMaya *>(newAppNode.get())->nodeObj = pending.node;
+  return true;
+}
+
+// importPolyMesh of _import.py
+bool SceneNodeMaya::createPolyMeshNode(SceneNodeAlembicPtr fileNode,
+                                       SceneNodeAppPtr &newAppNode)
+{
+  ESS_PROFILE_SCOPE("SceneNodeMaya::createPolyMeshNode");
+  MStatus status;
+  MObject parent =
+      nodeObj.isNull() ? findMObjectByName(dccIdentifier.c_str()) : nodeObj;
+
+  if (!fileAndTime->pendingMod) {
+    fileAndTime->pendingMod.reset(new MDagModifier());
+  }
+  MDagModifier &dagMod = *fileAndTime->pendingMod;
+  PendingMayaNode pending;
+  pending.node = dagMod.createNode("mesh", parent, &status);
+  if (status != MS::kSuccess) {
+    return false;
+  }
+  dagMod.renameNode(pending.node, fileNode->name.c_str());
+  pending.reader =
+      dagMod.MDGModifier::createNode("ExocortexAlembicPolyMesh", &status);
+  if (status != MS::kSuccess) {
+    return false;
+  }
+
+  pending.appNode = newAppNode;
+  pending.fileNode = fileNode;
+  pending.isMesh = true;
+  fileAndTime->pendingNodes.push_back(pending);
+  static_cast<SceneNodeMaya *>(newAppNode.get())->nodeObj = pending.node;
+  return true;
+}
+
+// the hierarchy is created by a single doIt, then the readers are connected
+// and the meshes assigned to the initial shading group at once. The deformers
+// are created once the meshes are connected to their topology readers, their
+// readers and the props of all the nodes go in a last modifier.
+bool SceneNodeMaya::createPendingNodes(const IJobStringParser &jobParams)
+{
+  if (fileAndTime->pendingNodes.empty()) {
+    return true;
+  }
+
+  ESS_PROFILE_SCOPE("SceneNodeMaya::createPendingNodes");
+  std::vector<PendingMayaNode> pendingNodes;
+  pendingNodes.swap(fileAndTime->pendingNodes);
+  std::shared_ptr<MDagModifier> dagMod;
+  dagMod.swap(fileAndTime->pendingMod);
+  if (dagMod->doIt() != MS::kSuccess) {
+    return false;
+  }
+
+  static const char *xformPlugs[][2] = {{"translate", "translate"},
+                                        {"rotate", "rotate"},
+                                        {"scale", "scale"},
+                                        {"outVisibility", "visibility"}};
+  MDGModifier dgMod;
+  MString shapes, faceSetsCmd, deformerCmd;
+  for (size_t i = 0; i < pendingNodes.size(); ++i) {
+    const PendingMayaNode &pending = pendingNodes[i];
+    MFnDagNode dagNode(pending.node);
+    MFnDependencyNode readerDepNode(pending.reader);
+    const MString path = dagNode.fullPathName();
+    const MString shapePath = melString(path.asChar());
+    const std::string &identifier = pending.fileNode->dccIdentifier;
+
+    pending.appNode->dccIdentifier = path.asChar();
+    pending.appNode->name = pending.appNode->dccIdentifier;
+    pending.appNode->dccReaderIdentifier = readerDepNode.name().asChar();
+    readerDepNode.findPlug("identifier", true)
+        .setValue(MString(identifier.c_str()));
+
+    if (!pending.isMesh) {
+      for (int j = 0; j < 4; ++j) {
+        dgMod.connect(readerDepNode.findPlug(xformPlugs[j][0], true),
+                      dagNode.findPlug(xformPlugs[j][1], true));
+      }
+      if (!connectReader(dgMod, readerDepNode, true)) {
+        return false;
+      }
+      continue;
+    }
+
+    // the points are deformed unless the topology changes
+    const bool dynamicTopology = pending.fileNode->pObjCache->isMeshTopoDynamic;
+    readerDepNode.findPlug("normals", true).setValue(jobParams.importNormals);
+    readerDepNode.findPlug("uvs", true).setValue(jobParams.importUVs);
+    dgMod.connect(readerDepNode.findPlug("outMesh", true),
+                  dagNode.findPlug("inMesh", true));
+    if (!connectReader(dgMod, readerDepNode, dynamicTopology)) {
+      return false;
+    }
+    shapes += " " + shapePath;
+    if (jobParams.importFacesets) {
+      faceSetsCmd += "ExocortexAlembic_createFaceSets -o " + shapePath +
+                     " -f " + melString(jobParams.filename) + " -i " +
+                     melString(identifier) + ";\n";
+    }
+    if (!dynamicTopology) {
+      deformerCmd +=
+          "deformer -type ExocortexAlembicPolyMeshDeform " + shapePath + ";\n";
+    }
+  }
+  if (shapes.length() > 0) {
+    dgMod.commandToExecute("sets -e -forceElement initialShadingGroup" +
+                           shapes);
+  }
+  if (dgMod.doIt() != MS::kSuccess) {
+    return false;
+  }
+  if (faceSetsCmd.length() > 0) {
+    MGlobal::executeCommand(faceSetsCmd);
+  }
+  if (deformerCmd.length() > 0 &&
+      MGlobal::executeCommand(deformerCmd) != MS::kSuccess) {
+    return false;
+  }
+
+  const MString fileName(jobParams.filename.c_str());
+  MDGModifier propsMod;
+  for (size_t i = 0; i < pendingNodes.size(); ++i) {
+    const PendingMayaNode &pending = pendingNodes[i];
+    const MString identifier(pending.fileNode->dccIdentifier.c_str());
+    if (!pending.isMesh) {
+      if (!addAndConnectProps<Alembic::AbcGeom::IXform,
+                              Alembic::AbcGeom::IXformSchema>(
+              pending.node, pending.reader, fileName, identifier, true,
+              propsMod)) {
+        return false;
+      }
+      continue;
+    }
+
+    // the deformer is the node feeding the shape, as in visitChild
+    MObject reader = pending.reader;
+    if (!pending.fileNode->pObjCache->isMeshTopoDynamic) {
+      MFnDependencyNode shapeDepNode(pending.node);
+      MPlugArray connections;
+      if (!shapeDepNode.findPlug("inMesh", true)
+               .connectedTo(connections, true, false) ||
+          connections.length() == 0) {
+        return false;
+      }
+      reader = connections[0].node();
+
+      MFnDependencyNode readerDepNode(reader);
+      if (!connectReader(propsMod, readerDepNode, true)) {
+        return false;
+      }
+      readerDepNode.findPlug("identifier", true).setValue(identifier);
+      pending.appNode->dccReaderIdentifier = readerDepNode.name().asChar();
+    }
+    if (!addAndConnectProps<Alembic::AbcGeom::IPolyMesh,
+                            Alembic::AbcGeom::IPolyMeshSchema>(
+            pending.node, reader, fileName, identifier, true, propsMod)) {
+      return false;
+    }
+  }
+  return propsMod.doIt() == MS::kSuccess;
+}
+
 bool SceneNodeMaya::addSimilarChild(const char *functionName,
                                     SceneNodeAlembicPtr fileNode,
                                     SceneNodeAppPtr &newAppNode)
@@ -246,6 +496,10 @@ bool SceneNodeMaya::addXformChild(SceneNodeAlembicPtr fileNode,
       "ExoAlembic._import.importXform(r\"^1s\", r\"^2s\", ^3s, ^4s, ^5s)");
 
   ESS_PROFILE_SCOPE("SceneNodeMaya::addXformChild");
+  if (canCreateNode(fileNode, false)) {
+    return createXformNode(fileNode, newAppNode);
+  }
+
   MString parent;
   switch (type) {
     case ETRANSFORM:
@@ -271,6 +525,7 @@ bool SceneNodeMaya::addXformChild(SceneNodeAlembicPtr fileNode,
 }
 
 bool SceneNodeMaya::addPolyMeshChild(SceneNodeAlembicPtr fileNode,
+                                     const IJobStringParser &jobParams,
                                      SceneNodeAppPtr &newAppNode)
 {
   static const MString format(
@@ -278,6 +533,10 @@ bool SceneNodeMaya::addPolyMeshChild(SceneNodeAlembicPtr fileNode,
       "^5s, ^6s)");
 
   ESS_PROFILE_SCOPE("SceneNodeMaya::addPolyMeshChild");
+  if (canCreateNode(fileNode, true)) {
+    return createPolyMeshNode(fileNode, newAppNode);
+  }
+
   MString cmd;
   cmd.format(format, fileNode->name.c_str(), fileNode->dccIdentifier.c_str(),
              fileAndTime->variable(), dccIdentifier.c_str(),
@@ -329,6 +588,25 @@ bool SceneNodeMaya::addChild(SceneNodeAlembicPtr fileNode,
   ESS_PROFILE_SCOPE("SceneNodeMaya::addChild");
   this->useMultiFile = jobParams.useMultiFile;
   newAppNode.reset(new SceneNodeMaya(fileAndTime));
+
+  // the nodes created by Python need the names of their parents
+  bool queued = false;
+  switch (fileNode->type) {
+    case ETRANSFORM:
+    case ITRANSFORM:
+      queued = canCreateNode(fileNode, false);
+      break;
+    case POLYMESH:
+    case SUBD:
+      queued = canCreateNode(fileNode, true);
+      break;
+    default:
+      break;
+  }
+  if (!queued && !createPendingNodes(jobParams)) {
+    return false;
+  }
+
   switch (newAppNode->type = fileNode->type) {
     case ETRANSFORM:
     case ITRANSFORM:
@@ -342,7 +620,7 @@ bool SceneNodeMaya::addChild(SceneNodeAlembicPtr fileNode,
                  newAppNode);
     case POLYMESH:
     case SUBD:
-      return addPolyMeshChild(fileNode, newAppNode);
+      return addPolyMeshChild(fileNode, jobParams, newAppNode);
     case CURVES:
     case HAIR:
       return addCurveChild(fileNode, newAppNode);
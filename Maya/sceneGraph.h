@@ -6,22 +6,45 @@
 #include "CommonSceneGraph.h"
 #include "AttributesReading.h"
 
+#include <maya/MDGModifier.h>
+#include <maya/MDagModifier.h>
+
 static inline const MString &PythonBool(bool b);
 
 class AlembicFileAndTimeControl;
 typedef std::shared_ptr<AlembicFileAndTimeControl>
     AlembicFileAndTimeControlPtr;
 
+// a transform or a mesh queued in the modifier of the import, with its reader
+struct PendingMayaNode {
+  SceneNodeAppPtr appNode;
+  SceneNodeAlembicPtr fileNode;
+  MObject node;
+  MObject reader;
+  bool isMesh;
+};
+
 // Will also hold all the informations about the IJobString necessary!
 class AlembicFileAndTimeControl {
  private:
   MString var;
+  MObject fileNodeObj;
+  MObject timeControlObj;
+
+  // the nodes created with the API are all queued in a single modifier, see
+  // SceneNodeMaya::createPendingNodes
+  std::shared_ptr<MDagModifier> pendingMod;
+  std::vector<PendingMayaNode> pendingNodes;
 
   AlembicFileAndTimeControl(const MString& variable) : var(variable) {}
+
+  friend class SceneNodeMaya;
  public:
   ~AlembicFileAndTimeControl(void);
 
   const MString& variable(void) const { return var; }
+  const MObject& fileNode(void) const { return fileNodeObj; }
+  const MObject& timeControl(void) const { return timeControlObj; }
   static AlembicFileAndTimeControlPtr createControl(
       const IJobStringParser& jobParams);
 };
@@ -32,39 +55,26 @@ class SceneNodeMaya : public SceneNodeApp {
  private:
   AlembicFileAndTimeControlPtr fileAndTime;
   bool useMultiFile;
+  MObject nodeObj;  // created with the API, valid before it is named
 
   bool removeProps(const MString &dccReaderIdentifier);
   bool connectProps(MFnDependencyNode &depNode,
-      MFnDependencyNode &readerDepNode);
+      MFnDependencyNode &readerDepNode, MDGModifier &mod);
 
   template<typename OBJECT_TYPE, typename SCHEMA_TYPE>
-    bool addAndConnectProps(const MString &dccIdentifier,
-        const MString &dccReaderIdentifier,
-        bool addPropsToShape)
+    bool addAndConnectProps(MObject node, MObject readerNode,
+        const MString &fileName, const MString &identifier,
+        bool addPropsToShape, MDGModifier &mod)
     {
       MStatus status;
-      MObject node = findMObjectByName(dccIdentifier);
-      MObject readerNode = findMObjectByName(dccReaderIdentifier);
-
       MFnDependencyNode depNode(node, &status);
       MFnDependencyNode readerDepNode(readerNode, &status);
 
-      MPlug fileNamePlug = readerDepNode.findPlug("fileName", &status);
-      MPlug identifierPlug = readerDepNode.findPlug("identifier", &status);
       MPlug geomParamsPlug = readerDepNode.findPlug("ExocortexAlembic_GeomParams",
           &status);
       MPlug userAttrsPlug = readerDepNode.findPlug("ExocortexAlembic_UserAttributes",
           &status);
 
-      MString fileName;
-      status = fileNamePlug.getValue(fileName);
-      MString identifier;
-      status = identifierPlug.getValue(identifier);
-
-      if (status != MStatus::kSuccess) {
-        return false;
-      }
-
       // Don't show these warnings; let the reader node display them
       Alembic::Abc::IObject iObj = getObjectFromArchive(fileName, identifier);
       if (!iObj.valid()) {
@@ -95,7 +105,37 @@ class SceneNodeMaya : public SceneNodeApp {
       geomParamsPlug.setValue(arbPropStr.c_str());
       userAttrsPlug.setValue(userPropStr.c_str());
 
-      return connectProps(depNode, readerDepNode);
+      return connectProps(depNode, readerDepNode, mod);
+    }
+
+  template<typename OBJECT_TYPE, typename SCHEMA_TYPE>
+    bool addAndConnectProps(const MString &dccIdentifier,
+        const MString &dccReaderIdentifier,
+        bool addPropsToShape)
+    {
+      MStatus status;
+      MObject readerNode = findMObjectByName(dccReaderIdentifier);
+      MFnDependencyNode readerDepNode(readerNode, &status);
+
+      MPlug fileNamePlug = readerDepNode.findPlug("fileName", &status);
+      MPlug identifierPlug = readerDepNode.findPlug("identifier", &status);
+
+      MString fileName;
+      status = fileNamePlug.getValue(fileName);
+      MString identifier;
+      status = identifierPlug.getValue(identifier);
+
+      if (status != MStatus::kSuccess) {
+        return false;
+      }
+
+      MDGModifier mod;
+      if (!addAndConnectProps<OBJECT_TYPE, SCHEMA_TYPE>(
+            findMObjectByName(dccIdentifier), readerNode, fileName, identifier,
+            addPropsToShape, mod)) {
+        return false;
+      }
+      return mod.doIt() == MStatus::kSuccess;
     }
 
   template<typename OBJECT_TYPE, typename SCHEMA_TYPE>
@@ -157,11 +197,22 @@ class SceneNodeMaya : public SceneNodeApp {
   // --- add child
   bool executeAddChild(const MString& cmd, SceneNodeAppPtr& newAppNode);
 
+  // the transforms and meshes are queued in the modifier of the import and
+  // created with createPendingNodes
+  bool canCreateNode(SceneNodeAlembicPtr fileNode, bool needsParent) const;
+  bool connectReader(MDGModifier& mod, MFnDependencyNode& readerDepNode,
+                     bool connectTime);
+  bool createXformNode(SceneNodeAlembicPtr fileNode,
+                       SceneNodeAppPtr& newAppNode);
+  bool createPolyMeshNode(SceneNodeAlembicPtr fileNode,
+                          SceneNodeAppPtr& newAppNode);
+
   // because camera, curves and points work the same way!
   bool addSimilarChild(const char* functionName, SceneNodeAlembicPtr fileNode,
                        SceneNodeAppPtr& newAppNode);
   bool addXformChild(SceneNodeAlembicPtr fileNode, SceneNodeAppPtr& newAppNode);
   bool addPolyMeshChild(SceneNodeAlembicPtr fileNode,
+                        const IJobStringParser& jobParams,
                         SceneNodeAppPtr& newAppNode);
   bool addCurveChild(SceneNodeAlembicPtr fileNode, SceneNodeAppPtr& newAppNode);
 
@@ -181,6 +232,10 @@ class SceneNodeMaya : public SceneNodeApp {
                         const IJobStringParser& jobParams,
                         SceneNodeAppPtr& newAppNode);
   virtual void print(void);
+
+  // creates the nodes queued by the import, before a node needs the name of
+  // its parent and once the import is done
+  bool createPendingNodes(const IJobStringParser& jobParams);
 };
 
 /*
@@ -0,0 +1,368 @@
+#include "stdafx.h"
+
+#include "archivecompare.h"
+#include <sstream>
+#include "extension.h"
+#include "iarchive.h"
+
+namespace {
+
+std::string joinPath(const std::string &path, const std::string &name)
+{
+  return path == "/" ? path + name : path + "/" + name;
+}
+
+struct archiveDifference {
+  std::string path;
+  const char *kind;
+  std::string description;
+};
+
+// Walks two hierarchies side by side and lists their differences. Array
+// samples are compared on their digests (ArraySampleKey), they are only read
+// and compared value by value when the digests differ and an epsilon is given,
+// or when a digest isn't available.
+class archiveComparer {
+ public:
+  archiveComparer(bool useEpsilon, double epsilon)
+      : mUseEpsilon(useEpsilon), mEpsilon(epsilon)
+  {
+  }
+
+  void compareObjects(const Abc::IObject &obj1, const Abc::IObject &obj2);
+
+  const std::vector<archiveDifference> &getDifferences() const
+  {
+    return mDifferences;
+  }
+
+ private:
+  void add(const std::string &path, const char *kind,
+           const std::string &description);
+
+  void compareProperties(const Abc::ICompoundProperty &props1,
+                         const Abc::ICompoundProperty &props2,
+                         const std::string &path);
+  void compareProperty(const Abc::ICompoundProperty &props1,
+                       const Abc::ICompoundProperty &props2,
+                       const AbcA::PropertyHeader &header,
+                       const std::string &path);
+
+  template <class PROP>
+  void compareSamples(const PROP &prop1, const PROP &prop2,
+                      const std::string &path);
+  bool sameSample(const Abc::IScalarProperty &prop1,
+                  const Abc::IScalarProperty &prop2, size_t index);
+  bool sameSample(const Abc::IArrayProperty &prop1,
+                  const Abc::IArrayProperty &prop2, size_t index);
+
+  bool sameValues(const void *values1, const void *values2,
+                  const AbcA::DataType &dataType, size_t nbElements) const;
+  template <typename T>
+  bool sameReals(const T *values1, const T *values2, size_t count) const;
+
+  bool mUseEpsilon;
+  double mEpsilon;
+  std::vector<archiveDifference> mDifferences;
+};
+
+void archiveComparer::add(const std::string &path, const char *kind,
+                          const std::string &description)
+{
+  archiveDifference difference;
+  difference.path = path;
+  difference.kind = kind;
+  difference.description = description;
+  mDifferences.push_back(difference);
+}
+
+void archiveComparer::compareObjects(const Abc::IObject &obj1,
+                                     const Abc::IObject &obj2)
+{
+  const std::string &path = obj1.getFullName();
+  if (obj1.getMetaData().serialize() != obj2.getMetaData().serialize()) {
+    add(path, "metaData", "the metadata differ");
+  }
+
+  compareProperties(obj1.getProperties(), obj2.getProperties(), path);
+
+  for (size_t i = 0; i < obj1.getNumChildren(); ++i) {
+    const AbcA::ObjectHeader &header = obj1.getChildHeader(i);
+    if (!obj2.getChildHeader(header.getName())) {
+      add(header.getFullName(), "missing", "only in the first archive");
+      continue;
+    }
+    compareObjects(obj1.getChild(i), obj2.getChild(header.getName()));
+  }
+  for (size_t i = 0; i < obj2.getNumChildren(); ++i) {
+    const AbcA::ObjectHeader &header = obj2.getChildHeader(i);
+    if (!obj1.getChildHeader(header.getName())) {
+      add(header.getFullName(), "missing", "only in the second archive");
+    }
+  }
+}
+
+void archiveComparer::compareProperties(const Abc::ICompoundProperty &props1,
+                                        const Abc::ICompoundProperty &props2,
+                                        const std::string &path)
+{
+  for (size_t i = 0; i < props1.getNumProperties(); ++i) {
+    compareProperty(props1, props2, props1.getPropertyHeader(i), path);
+  }
+  for (size_t i = 0; i < props2.getNumProperties(); ++i) {
+    const std::string &name = props2.getPropertyHeader(i).getName();
+    if (!props1.getPropertyHeader(name)) {
+      add(joinPath(path, name), "missing", "only in the second archive");
+    }
+  }
+}
+
+void archiveComparer::compareProperty(const Abc::ICompoundProperty &props1,
+                                      const Abc::ICompoundProperty &props2,
+                                      const AbcA::PropertyHeader &header,
+                                      const std::string &path)
+{
+  const std::string &name = header.getName();
+  const std::string propPath = joinPath(path, name);
+  const AbcA::PropertyHeader *header2 = props2.getPropertyHeader(name);
+  if (!header2) {
+    add(propPath, "missing", "only in the first archive");
+    return;
+  }
+  if (header.getPropertyType() != header2->getPropertyType() ||
+      (!header.isCompound() &&
+       !(header.getDataType() == header2->getDataType()))) {
+    add(propPath, "type", "the property types differ");
+    return;
+  }
+  if (header.getMetaData().serialize() !=
+      header2->getMetaData().serialize()) {
+    add(propPath, "metaData", "the metadata differ");
+  }
+
+  if (header.isCompound()) {
+    compareProperties(Abc::ICompoundProperty(props1, name),
+                      Abc::ICompoundProperty(props2, name), propPath);
+  }
+  else if (header.isScalar()) {
+    compareSamples(Abc::IScalarProperty(props1, name),
+                   Abc::IScalarProperty(props2, name), propPath);
+  }
+  else {
+    compareSamples(Abc::IArrayProperty(props1, name),
+                   Abc::IArrayProperty(props2, name), propPath);
+  }
+}
+
+template <class PROP>
+void archiveComparer::compareSamples(const PROP &prop1, const PROP &prop2,
+                                     const std::string &path)
+{
+  if (!(*prop1.getTimeSampling() == *prop2.getTimeSampling())) {
+    add(path, "timeSampling", "the time samplings differ");
+  }
+
+  const size_t nbSamples1 = prop1.getNumSamples();
+  const size_t nbSamples2 = prop2.getNumSamples();
+  if (nbSamples1 != nbSamples2) {
+    std::stringstream description;
+    description << nbSamples1 << " samples against " << nbSamples2;
+    add(path, "nbSamples", description.str());
+  }
+
+  // only the common samples are compared
+  const size_t nbSamples = std::min(nbSamples1, nbSamples2);
+  size_t nbDifferent = 0, firstDifferent = 0;
+  for (size_t i = 0; i < nbSamples; ++i) {
+    if (!sameSample(prop1, prop2, i)) {
+      if (nbDifferent++ == 0) {
+        firstDifferent = i;
+      }
+    }
+  }
+  if (nbDifferent) {
+    std::stringstream description;
+    description << nbDifferent << " of " << nbSamples
+                << " samples differ, the first one is #" << firstDifferent;
+    add(path, "values", description.str());
+  }
+}
+
+bool archiveComparer::sameSample(const Abc::IScalarProperty &prop1,
+                                 const Abc::IScalarProperty &prop2,
+                                 size_t index)
+{
+  const Abc::ISampleSelector selector((AbcA::index_t)index);
+  const AbcA::DataType &dataType = prop1.getDataType();
+
+  // strings are read as arrays of std::string
+  if (dataType.getPod() == AbcA::kStringPOD) {
+    std::vector<std::string> values1(dataType.getExtent());
+    std::vector<std::string> values2(dataType.getExtent());
+    prop1.get(&values1[0], selector);
+    prop2.get(&values2[0], selector);
+    return values1 == values2;
+  }
+  if (dataType.getPod() == AbcA::kWstringPOD) {
+    std::vector<std::wstring> values1(dataType.getExtent());
+    std::vector<std::wstring> values2(dataType.getExtent());
+    prop1.get(&values1[0], selector);
+    prop2.get(&values2[0], selector);
+    return values1 == values2;
+  }
+
+  std::vector<char> values1(dataType.getNumBytes());
+  std::vector<char> values2(dataType.getNumBytes());
+  prop1.get(&values1[0], selector);
+  prop2.get(&values2[0], selector);
+  return sameValues(&values1[0], &values2[0], dataType, 1);
+}
+
+bool archiveComparer::sameSample(const Abc::IArrayProperty &prop1,
+                                 const Abc::IArrayProperty &prop2,
+                                 size_t index)
+{
+  const Abc::ISampleSelector selector((AbcA::index_t)index);
+
+  // the shape first, the same values can be laid out differently
+  AbcA::Dimensions dims1, dims2;
+  prop1.getDimensions(dims1, selector);
+  prop2.getDimensions(dims2, selector);
+  if (!(dims1 == dims2)) {
+    return false;
+  }
+
+  AbcA::ArraySampleKey key1, key2;
+  if (prop1.getKey(key1, selector) && prop2.getKey(key2, selector)) {
+    if (key1 == key2) {
+      return true;
+    }
+    if (!mUseEpsilon) {
+      return false;
+    }
+  }
+
+  AbcA::ArraySamplePtr sample1, sample2;
+  prop1.get(sample1, selector);
+  prop2.get(sample2, selector);
+  return sameValues(sample1->getData(), sample2->getData(),
+                    prop1.getDataType(), sample1->size());
+}
+
+template <typename T>
+bool archiveComparer::sameReals(const T *values1, const T *values2,
+                                size_t count) const
+{
+  for (size_t i = 0; i < count; ++i) {
+    const double value1 = (double)(float)values1[i];
+    const double value2 = (double)(float)values2[i];
+    if (fabs(value1 - value2) > mEpsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <>
+bool archiveComparer::sameReals(const double *values1, const double *values2,
+                                size_t count) const
+{
+  for (size_t i = 0; i < count; ++i) {
+    if (fabs(values1[i] - values2[i]) > mEpsilon) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool archiveComparer::sameValues(const void *values1, const void *values2,
+                                 const AbcA::DataType &dataType,
+                                 size_t nbElements) const
+{
+  const size_t count = nbElements * dataType.getExtent();
+  switch (dataType.getPod()) {
+    case AbcA::kStringPOD:
+      return std::equal((const std::string *)values1,
+                        (const std::string *)values1 + count,
+                        (const std::string *)values2);
+    case AbcA::kWstringPOD:
+      return std::equal((const std::wstring *)values1,
+                        (const std::wstring *)values1 + count,
+                        (const std::wstring *)values2);
+    case AbcA::kFloat16POD:
+      if (mUseEpsilon) {
+        return sameReals((const AbcU::float16_t *)values1,
+                         (const AbcU::float16_t *)values2, count);
+      }
+      break;
+    case AbcA::kFloat32POD:
+      if (mUseEpsilon) {
+        return sameReals((const float *)values1, (const float *)values2,
+                         count);
+      }
+      break;
+    case AbcA::kFloat64POD:
+      if (mUseEpsilon) {
+        return sameReals((const double *)values1, (const double *)values2,
+                         count);
+      }
+      break;
+    default:
+      break;
+  }
+  return memcmp(values1, values2,
+                count * AbcA::PODNumBytes(dataType.getPod())) == 0;
+}
+
+}  // namespace
+
+PyObject *compareArchives(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  ALEMBIC_TRY_STATEMENT
+  static char *kwlist[] = {(char *)"iArchive1", (char *)"iArchive2",
+                           (char *)"epsilon", NULL};
+
+  PyObject *pyArchive1 = NULL, *pyArchive2 = NULL, *pyEpsilon = NULL;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist, &pyArchive1,
+                                   &pyArchive2, &pyEpsilon)) {
+    PyErr_SetString(getError(), "No iArchives specified!");
+    return NULL;
+  }
+  if (!PyObject_iArchive_Check(pyArchive1) ||
+      !PyObject_iArchive_Check(pyArchive2)) {
+    PyErr_SetString(getError(), "Both arguments should be iArchives!");
+    return NULL;
+  }
+
+  const bool useEpsilon = pyEpsilon != NULL && pyEpsilon != Py_None;
+  double epsilon = 0.0;
+  if (useEpsilon) {
+    epsilon = PyFloat_AsDouble(pyEpsilon);
+    if (PyErr_Occurred() || epsilon < 0.0) {
+      PyErr_SetString(getError(), "epsilon should be a positive number!");
+      return NULL;
+    }
+  }
+
+  iArchive *archive1 = (iArchive *)pyArchive1;
+  iArchive *archive2 = (iArchive *)pyArchive2;
+  archiveComparer comparer(useEpsilon, epsilon);
+  {
+    allowThreads threads(archive1->oType == AbcF::IFactory::kOgawa &&
+                         archive2->oType == AbcF::IFactory::kOgawa);
+    comparer.compareObjects(archive1->mArchive->getTop(),
+                            archive2->mArchive->getTop());
+  }
+
+  const std::vector<archiveDifference> &differences =
+      comparer.getDifferences();
+  PyObject *list = PyList_New(differences.size());
+  for (size_t i = 0; i < differences.size(); ++i) {
+    PyList_SET_ITEM(list, i, Py_BuildValue("(sss)",
+                                           differences[i].path.c_str(),
+                                           differences[i].kind,
+                                           differences[i].description.c_str()));
+  }
+  return list;
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
@@ -0,0 +1,6 @@
+#ifndef _PYTHON_ALEMBIC_ARCHIVECOMPARE_H_
+#define _PYTHON_ALEMBIC_ARCHIVECOMPARE_H_
+
+PyObject *compareArchives(PyObject *self, PyObject *args, PyObject *kwds);
+
+#endif
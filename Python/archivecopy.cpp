@@ -0,0 +1,548 @@
+#include "stdafx.h"
+
+#include "archivecopy.h"
+#include <limits>
+#include "CommonRegex.h"
+#include "extension.h"
+#include "iarchive.h"
+#include "oarchive.h"
+#include "objectfilter.h"
+
+namespace {
+
+struct archiveCopyOptions {
+  std::vector<std::string> includes;  // subtrees to copy, all if empty
+  std::vector<std::string> excludes;  // subtrees to skip
+  std::vector<std::string> schemas;   // types of the objects to copy
+  std::vector<std::string> excludeSchemas;  // types of the objects to skip
+  SearchReplace::ReplacePtr renamer;  // applied to every object name
+  double timeScale;
+  double timeOffset;
+};
+
+// Copies the hierarchy of one or several input archives into an output
+// archive, straight from Alembic to Alembic. Array samples are handed over
+// without being converted, and the ones that didn't change since the previous
+// sample aren't even read.
+//
+// With several inputs, the hierarchy of the first archive is copied and the
+// samples of the matching properties of the following archives are appended,
+// every archive starting one sample step after the end of the previous one.
+class archiveCopier {
+ public:
+  archiveCopier(const std::vector<Abc::IArchive *> &inputs,
+                Abc::OArchive &output, const archiveCopyOptions &options)
+      : mInputs(inputs), mOutput(output), mOptions(options), mNbObjects(0)
+  {
+  }
+
+  // returns the number of objects copied
+  size_t copy();
+
+ private:
+  typedef std::vector<Abc::IObject> objectVec;
+  typedef std::vector<Abc::ICompoundProperty> compoundVec;
+
+  bool selectObjects(const Abc::IObject &obj, bool included);
+  void computeArchiveShifts();
+
+  void copyObject(const objectVec &sources, Abc::OObject &parent);
+  void copyProperties(const compoundVec &sources, Abc::OCompoundProperty &dest);
+  void copyScalarProperty(const compoundVec &parents,
+                          const AbcA::PropertyHeader &header,
+                          Abc::OCompoundProperty &dest);
+  void copyArrayProperty(const compoundVec &parents,
+                         const AbcA::PropertyHeader &header,
+                         Abc::OCompoundProperty &dest);
+
+  // the archives holding a property matching header, among parents
+  std::vector<size_t> findProperty(const compoundVec &parents,
+                                   const AbcA::PropertyHeader &header) const;
+  uint32_t getTimeSamplingIndex(const std::vector<size_t> &archives,
+                                const std::vector<AbcA::TimeSamplingPtr> &ts,
+                                const std::vector<size_t> &nbSamples,
+                                const std::string &name);
+  uint32_t remapTimeSampling(const AbcA::TimeSampling &ts);
+
+  const std::vector<Abc::IArchive *> &mInputs;
+  Abc::OArchive &mOutput;
+  const archiveCopyOptions &mOptions;
+
+  std::set<std::string> mSelected;  // full names in the first archive
+  std::vector<Abc::chrono_t> mShifts;  // time offset of each input archive
+  size_t mNbObjects;
+};
+
+// first and last sample times of an archive, and its last sample step
+void getArchiveRange(const Abc::IArchive &archive, Abc::chrono_t &start,
+                     Abc::chrono_t &end, Abc::chrono_t &step)
+{
+  start = std::numeric_limits<Abc::chrono_t>::max();
+  end = -std::numeric_limits<Abc::chrono_t>::max();
+  step = 0.0;
+  for (uint32_t i = 0; i < archive.getNumTimeSamplings(); ++i) {
+    const AbcA::index_t nbSamples =
+        archive.getMaxNumSamplesForTimeSamplingIndex(i);
+    if (nbSamples <= 0 ||
+        nbSamples == std::numeric_limits<AbcA::index_t>::max()) {
+      continue;  // unused or unknown
+    }
+
+    const AbcA::TimeSamplingPtr ts = archive.getTimeSampling(i);
+    const Abc::chrono_t last = ts->getSampleTime(nbSamples - 1);
+    start = std::min(start, ts->getSampleTime(0));
+    if (last > end) {
+      end = last;
+      if (nbSamples > 1) {
+        step = last - ts->getSampleTime(nbSamples - 2);
+      }
+    }
+  }
+
+  if (start > end) {
+    start = end = 0.0;
+  }
+  if (step <= 0.0) {
+    step = 1.0 / 24.0;
+  }
+}
+
+size_t archiveCopier::copy()
+{
+  const Abc::IObject top = mInputs[0]->getTop();
+  for (size_t i = 0; i < top.getNumChildren(); ++i) {
+    selectObjects(top.getChild(i), false);
+  }
+  computeArchiveShifts();
+
+  objectVec tops(mInputs.size());
+  compoundVec topProps(mInputs.size());
+  for (size_t k = 0; k < mInputs.size(); ++k) {
+    tops[k] = mInputs[k]->getTop();
+    topProps[k] = tops[k].getProperties();
+  }
+
+  // the top object itself already exists in the output
+  Abc::OObject outTop = mOutput.getTop();
+  Abc::OCompoundProperty outTopProps = outTop.getProperties();
+  copyProperties(topProps, outTopProps);
+
+  for (size_t i = 0; i < top.getNumChildren(); ++i) {
+    const std::string &childName = top.getChildHeader(i).getName();
+    if (mSelected.find(top.getChildHeader(i).getFullName()) ==
+        mSelected.end()) {
+      continue;
+    }
+
+    objectVec children(mInputs.size());
+    for (size_t k = 0; k < mInputs.size(); ++k) {
+      if (tops[k].getChildHeader(childName)) {
+        children[k] = tops[k].getChild(childName);
+      }
+    }
+    copyObject(children, outTop);
+  }
+  return mNbObjects;
+}
+
+// an object is copied if it, or one of its ancestors, is included and none
+// of them is excluded. The schema filters only apply to the object itself,
+// not to its children. The ancestors of a copied object are copied as well.
+bool archiveCopier::selectObjects(const Abc::IObject &obj, bool included)
+{
+  const std::string &fullName = obj.getFullName();
+  if (matchAnyGlob(mOptions.excludes, fullName)) {
+    return false;
+  }
+
+  included = included || mOptions.includes.empty() ||
+             matchAnyGlob(mOptions.includes, fullName);
+  const std::string schema = obj.getMetaData().get("schema");
+  bool selected =
+      included &&
+      (mOptions.schemas.empty() || matchAnyGlob(mOptions.schemas, schema)) &&
+      !matchAnyGlob(mOptions.excludeSchemas, schema);
+  for (size_t i = 0; i < obj.getNumChildren(); ++i) {
+    selected = selectObjects(obj.getChild(i), included) || selected;
+  }
+
+  if (selected) {
+    mSelected.insert(fullName);
+  }
+  return selected;
+}
+
+void archiveCopier::computeArchiveShifts()
+{
+  mShifts.assign(mInputs.size(), 0.0);
+  Abc::chrono_t start, end, step;
+  getArchiveRange(*mInputs[0], start, end, step);
+  for (size_t k = 1; k < mInputs.size(); ++k) {
+    const Abc::chrono_t previousEnd = end + mShifts[k - 1];
+    const Abc::chrono_t previousStep = step;
+    getArchiveRange(*mInputs[k], start, end, step);
+    mShifts[k] = previousEnd + previousStep - start;
+  }
+}
+
+void archiveCopier::copyObject(const objectVec &sources, Abc::OObject &parent)
+{
+  const Abc::IObject &source = sources[0];
+  Abc::OObject dest(parent, mOptions.renamer->replace(source.getName()),
+                    source.getMetaData());
+  ++mNbObjects;
+
+  compoundVec props(sources.size());
+  for (size_t k = 0; k < sources.size(); ++k) {
+    if (sources[k].valid()) {
+      props[k] = sources[k].getProperties();
+    }
+  }
+  Abc::OCompoundProperty destProps = dest.getProperties();
+  copyProperties(props, destProps);
+
+  for (size_t i = 0; i < source.getNumChildren(); ++i) {
+    const AbcA::ObjectHeader &header = source.getChildHeader(i);
+    if (mSelected.find(header.getFullName()) == mSelected.end()) {
+      continue;
+    }
+
+    objectVec children(sources.size());
+    for (size_t k = 0; k < sources.size(); ++k) {
+      if (sources[k].valid() && sources[k].getChildHeader(header.getName())) {
+        children[k] = sources[k].getChild(header.getName());
+      }
+    }
+    copyObject(children, dest);
+  }
+}
+
+void archiveCopier::copyProperties(const compoundVec &sources,
+                                   Abc::OCompoundProperty &dest)
+{
+  const Abc::ICompoundProperty &source = sources[0];
+  for (size_t i = 0; i < source.getNumProperties(); ++i) {
+    const AbcA::PropertyHeader &header = source.getPropertyHeader(i);
+    if (dest.getPropertyHeader(header.getName())) {
+      continue;  // created with the output archive, like .childBnds
+    }
+
+    if (header.isCompound()) {
+      const std::vector<size_t> archives = findProperty(sources, header);
+      compoundVec children(sources.size());
+      for (size_t j = 0; j < archives.size(); ++j) {
+        children[archives[j]] =
+            Abc::ICompoundProperty(sources[archives[j]], header.getName());
+      }
+
+      Abc::OCompoundProperty child(dest, header.getName(),
+                                   header.getMetaData());
+      copyProperties(children, child);
+    }
+    else if (header.isScalar()) {
+      copyScalarProperty(sources, header, dest);
+    }
+    else {
+      copyArrayProperty(sources, header, dest);
+    }
+  }
+}
+
+std::vector<size_t> archiveCopier::findProperty(
+    const compoundVec &parents, const AbcA::PropertyHeader &header) const
+{
+  std::vector<size_t> archives;
+  for (size_t k = 0; k < parents.size(); ++k) {
+    if (!parents[k].valid()) {
+      continue;
+    }
+    const AbcA::PropertyHeader *found =
+        parents[k].getPropertyHeader(header.getName());
+    if (found && found->getPropertyType() == header.getPropertyType() &&
+        (header.isCompound() || found->getDataType() == header.getDataType())) {
+      archives.push_back(k);
+    }
+  }
+  return archives;
+}
+
+uint32_t archiveCopier::remapTimeSampling(const AbcA::TimeSampling &ts)
+{
+  if (mOptions.timeScale == 1.0 && mOptions.timeOffset == 0.0) {
+    return mOutput.addTimeSampling(ts);
+  }
+
+  std::vector<Abc::chrono_t> times = ts.getStoredTimes();
+  for (size_t i = 0; i < times.size(); ++i) {
+    times[i] = times[i] * mOptions.timeScale + mOptions.timeOffset;
+  }
+
+  AbcA::TimeSamplingType type = ts.getTimeSamplingType();
+  if (!type.isAcyclic()) {
+    type = AbcA::TimeSamplingType(type.getNumSamplesPerCycle(),
+                                  type.getTimePerCycle() * mOptions.timeScale);
+  }
+  return mOutput.addTimeSampling(AbcA::TimeSampling(type, times));
+}
+
+uint32_t archiveCopier::getTimeSamplingIndex(
+    const std::vector<size_t> &archives,
+    const std::vector<AbcA::TimeSamplingPtr> &ts,
+    const std::vector<size_t> &nbSamples, const std::string &name)
+{
+  if (archives.size() == 1) {
+    // only found in the first archive, which is never shifted
+    return remapTimeSampling(*ts[0]);
+  }
+
+  // concatenated samples, the sampling is rebuilt from the actual times
+  std::vector<Abc::chrono_t> times;
+  for (size_t j = 0; j < archives.size(); ++j) {
+    for (size_t i = 0; i < nbSamples[j]; ++i) {
+      const Abc::chrono_t time =
+          (ts[j]->getSampleTime((AbcA::index_t)i) + mShifts[archives[j]]) *
+              mOptions.timeScale +
+          mOptions.timeOffset;
+      if (!times.empty() && time <= times.back()) {
+        ABCA_THROW("Overlapping samples, can't concatenate property "
+                   << name << "!");
+      }
+      times.push_back(time);
+    }
+  }
+
+  if (times.empty()) {
+    return remapTimeSampling(*ts[0]);
+  }
+  return mOutput.addTimeSampling(AbcA::TimeSampling(
+      AbcA::TimeSamplingType(AbcA::TimeSamplingType::kAcyclic), times));
+}
+
+template <typename T>
+void copyScalarSamples(const std::vector<Abc::IScalarProperty> &sources,
+                       Abc::OScalarProperty &dest, size_t count)
+{
+  std::vector<T> buffer(count);
+  for (size_t k = 0; k < sources.size(); ++k) {
+    const size_t nbSamples = sources[k].getNumSamples();
+    for (size_t i = 0; i < nbSamples; ++i) {
+      sources[k].get(&buffer[0], Abc::ISampleSelector((AbcA::index_t)i));
+      dest.set(&buffer[0]);
+    }
+  }
+}
+
+void archiveCopier::copyScalarProperty(const compoundVec &parents,
+                                       const AbcA::PropertyHeader &header,
+                                       Abc::OCompoundProperty &dest)
+{
+  const std::vector<size_t> archives = findProperty(parents, header);
+  std::vector<Abc::IScalarProperty> sources;
+  std::vector<AbcA::TimeSamplingPtr> ts;
+  std::vector<size_t> nbSamples;
+  for (size_t j = 0; j < archives.size(); ++j) {
+    sources.push_back(
+        Abc::IScalarProperty(parents[archives[j]], header.getName()));
+    ts.push_back(sources.back().getTimeSampling());
+    nbSamples.push_back(sources.back().getNumSamples());
+  }
+
+  const AbcA::DataType &dataType = header.getDataType();
+  Abc::OScalarProperty prop(
+      dest, header.getName(), dataType, header.getMetaData(),
+      getTimeSamplingIndex(archives, ts, nbSamples, header.getName()));
+
+  // strings are read and written as arrays of std::string
+  switch (dataType.getPod()) {
+    case AbcA::kStringPOD:
+      copyScalarSamples<std::string>(sources, prop, dataType.getExtent());
+      break;
+    case AbcA::kWstringPOD:
+      copyScalarSamples<std::wstring>(sources, prop, dataType.getExtent());
+      break;
+    default:
+      copyScalarSamples<char>(sources, prop, dataType.getNumBytes());
+      break;
+  }
+}
+
+void archiveCopier::copyArrayProperty(const compoundVec &parents,
+                                      const AbcA::PropertyHeader &header,
+                                      Abc::OCompoundProperty &dest)
+{
+  const std::vector<size_t> archives = findProperty(parents, header);
+  std::vector<Abc::IArrayProperty> sources;
+  std::vector<AbcA::TimeSamplingPtr> ts;
+  std::vector<size_t> nbSamples;
+  for (size_t j = 0; j < archives.size(); ++j) {
+    sources.push_back(
+        Abc::IArrayProperty(parents[archives[j]], header.getName()));
+    ts.push_back(sources.back().getTimeSampling());
+    nbSamples.push_back(sources.back().getNumSamples());
+  }
+
+  Abc::OArrayProperty prop(
+      dest, header.getName(), header.getDataType(), header.getMetaData(),
+      getTimeSamplingIndex(archives, ts, nbSamples, header.getName()));
+
+  // the key is the digest of the sample, no need to read it again if it
+  // matches the previous one
+  AbcA::ArraySampleKey previousKey;
+  bool hasPrevious = false;
+  for (size_t j = 0; j < sources.size(); ++j) {
+    for (size_t i = 0; i < nbSamples[j]; ++i) {
+      const Abc::ISampleSelector selector((AbcA::index_t)i);
+      AbcA::ArraySampleKey key;
+      const bool hasKey = sources[j].getKey(key, selector);
+      if (hasKey && hasPrevious && key == previousKey) {
+        prop.setFromPrevious();
+        continue;
+      }
+
+      AbcA::ArraySamplePtr sample;
+      sources[j].get(sample, selector);
+      prop.set(*sample);
+      previousKey = key;
+      hasPrevious = hasKey;
+    }
+  }
+}
+
+// None, a string or a sequence of strings
+bool getPatterns(PyObject *obj, std::vector<std::string> &patterns)
+{
+  if (obj == NULL || obj == Py_None) {
+    return true;
+  }
+  if (PyString_Check(obj)) {
+    patterns.push_back(PyString_AsString(obj));
+    return true;
+  }
+
+  PyObject *seq = PySequence_Fast(obj, "");
+  if (seq == NULL) {
+    return false;
+  }
+  const Py_ssize_t nbItems = PySequence_Fast_GET_SIZE(seq);
+  for (Py_ssize_t i = 0; i < nbItems; ++i) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    if (!PyString_Check(item)) {
+      Py_DECREF(seq);
+      return false;
+    }
+    patterns.push_back(PyString_AsString(item));
+  }
+  Py_DECREF(seq);
+  return true;
+}
+
+}  // namespace
+
+PyObject *copyArchives(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  ALEMBIC_TRY_STATEMENT
+  static char *kwlist[] = {(char *)"inputs",     (char *)"oArchive",
+                           (char *)"include",    (char *)"exclude",
+                           (char *)"rename",     (char *)"timeScale",
+                           (char *)"timeOffset", (char *)"schema",
+                           (char *)"excludeSchema", NULL};
+
+  PyObject *pyInputs = NULL, *pyOutput = NULL;
+  PyObject *pyIncludes = NULL, *pyExcludes = NULL, *pyRename = NULL;
+  PyObject *pySchemas = NULL, *pyExcludeSchemas = NULL;
+  archiveCopyOptions options;
+  options.timeScale = 1.0;
+  options.timeOffset = 0.0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|OOOddOO", kwlist, &pyInputs,
+                                   &pyOutput, &pyIncludes, &pyExcludes,
+                                   &pyRename, &options.timeScale,
+                                   &options.timeOffset, &pySchemas,
+                                   &pyExcludeSchemas)) {
+    PyErr_SetString(getError(), "No input iArchives and oArchive specified!");
+    return NULL;
+  }
+
+  // the input archives, a single one or a sequence
+  std::vector<Abc::IArchive *> inputs;
+  bool allOgawa = true;
+  if (PyObject_iArchive_Check(pyInputs)) {
+    inputs.push_back(((iArchive *)pyInputs)->mArchive);
+    allOgawa = ((iArchive *)pyInputs)->oType == AbcF::IFactory::kOgawa;
+  }
+  else {
+    PyObject *seq = PySequence_Fast(pyInputs, "");
+    if (seq == NULL) {
+      PyErr_SetString(getError(), "inputs should be an iArchive or a list!");
+      return NULL;
+    }
+    const Py_ssize_t nbItems = PySequence_Fast_GET_SIZE(seq);
+    for (Py_ssize_t i = 0; i < nbItems; ++i) {
+      PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+      if (!PyObject_iArchive_Check(item)) {
+        Py_DECREF(seq);
+        PyErr_SetString(getError(), "item should be an iArchive!");
+        return NULL;
+      }
+      inputs.push_back(((iArchive *)item)->mArchive);
+      allOgawa = allOgawa &&
+                 ((iArchive *)item)->oType == AbcF::IFactory::kOgawa;
+    }
+    Py_DECREF(seq);
+  }
+  if (inputs.empty()) {
+    PyErr_SetString(getError(), "No input iArchive specified!");
+    return NULL;
+  }
+
+  if (!PyObject_oArchive_Check(pyOutput)) {
+    PyErr_SetString(getError(), "oArchive argument is not an oArchive!");
+    return NULL;
+  }
+  oArchive *output = (oArchive *)pyOutput;
+  if (output->mArchive == NULL) {
+    PyErr_SetString(getError(), "Archive already closed!");
+    return NULL;
+  }
+
+  if (!getPatterns(pyIncludes, options.includes) ||
+      !getPatterns(pyExcludes, options.excludes) ||
+      !getPatterns(pySchemas, options.schemas) ||
+      !getPatterns(pyExcludeSchemas, options.excludeSchemas)) {
+    PyErr_SetString(getError(),
+                    "include, exclude, schema and excludeSchema should be "
+                    "strings or lists of strings!");
+    return NULL;
+  }
+
+  options.renamer = SearchReplace::createReplacer();
+  if (pyRename != NULL && pyRename != Py_None) {
+    char *expression = NULL, *format = NULL;
+    if (!PyArg_ParseTuple(pyRename, "ss", &expression, &format)) {
+      PyErr_SetString(getError(),
+                      "rename should be a tuple (expression, format)!");
+      return NULL;
+    }
+    try {
+      options.renamer = SearchReplace::createReplacer(std::string(expression),
+                                                      std::string(format));
+    }
+    catch (std::exception &) {
+      PyErr_SetString(getError(), "Invalid rename expression!");
+      return NULL;
+    }
+  }
+
+  if (options.timeScale <= 0.0) {
+    PyErr_SetString(getError(), "timeScale should be positive!");
+    return NULL;
+  }
+
+  size_t nbObjects = 0;
+  {
+    allowThreads threads(allOgawa && output->mUseOgawa);
+    archiveCopier copier(inputs, *output->mArchive, options);
+    nbObjects = copier.copy();
+  }
+  return Py_BuildValue("i", (int)nbObjects);
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
@@ -0,0 +1,6 @@
+#ifndef _PYTHON_ALEMBIC_ARCHIVECOPY_H_
+#define _PYTHON_ALEMBIC_ARCHIVECOPY_H_
+
+PyObject *copyArchives(PyObject *self, PyObject *args, PyObject *kwds);
+
+#endif
@@ -0,0 +1,248 @@
+#include "stdafx.h"
+
+#include "arraysample.h"
+#include "extension.h"
+
+const char *ArraySample_getFormat(AbcA::PlainOldDataType pod)
+{
+  switch (pod) {
+    case AbcA::kBooleanPOD:
+      return "?";
+    case AbcA::kUint8POD:
+      return "B";
+    case AbcA::kInt8POD:
+      return "b";
+    case AbcA::kUint16POD:
+      return "H";
+    case AbcA::kInt16POD:
+      return "h";
+    case AbcA::kUint32POD:
+      return "I";
+    case AbcA::kInt32POD:
+      return "i";
+    case AbcA::kUint64POD:
+      return "Q";
+    case AbcA::kInt64POD:
+      return "q";
+    case AbcA::kFloat16POD:
+      return "e";  // PEP 3118 half, 'g' is a long double
+    case AbcA::kFloat32POD:
+      return "f";
+    case AbcA::kFloat64POD:
+      return "d";
+    default:
+      return NULL;
+  }
+}
+
+// 0 for booleans, 1 for signed integers, 2 for unsigned ones, 3 for reals
+static int ArraySample_getFormatKind(char format)
+{
+  switch (format) {
+    case '?':
+      return 0;
+    case 'b':
+    case 'h':
+    case 'i':
+    case 'l':
+    case 'q':
+      return 1;
+    case 'B':
+    case 'H':
+    case 'I':
+    case 'L':
+    case 'Q':
+      return 2;
+    case 'e':
+    case 'f':
+    case 'd':
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+bool ArraySample_isFormatOf(AbcA::PlainOldDataType pod, const char *format,
+                            Py_ssize_t itemsize)
+{
+  const char *podFormat = ArraySample_getFormat(pod);
+  if (podFormat == NULL ||
+      itemsize != (Py_ssize_t)AbcA::PODNumBytes(pod)) {
+    return false;
+  }
+  if (format == NULL) {
+    format = "B";  // plain bytes
+  }
+  // the sizes already match, so only the kind of the items matters
+  if (*format == '@' || *format == '=' || *format == '<') {
+    ++format;
+  }
+  if (format[0] == 0 || format[1] != 0) {
+    return false;
+  }
+  const int kind = ArraySample_getFormatKind(format[0]);
+  return kind >= 0 && kind == ArraySample_getFormatKind(podFormat[0]);
+}
+
+static Py_ssize_t ArraySample_getLength(EA_ArraySample *as)
+{
+  return as->shape[0] * as->shape[1] * as->itemsize;
+}
+
+// old style buffer interface, the only one known by Python 2.5
+static Py_ssize_t ArraySample_getReadBuffer(PyObject *self, Py_ssize_t segment,
+                                            void **ptr)
+{
+  if (segment != 0) {
+    PyErr_SetString(PyExc_SystemError,
+                    "accessing non-existent array sample segment");
+    return -1;
+  }
+  EA_ArraySample *as = (EA_ArraySample *)self;
+  *ptr = (void *)as->data;
+  return ArraySample_getLength(as);
+}
+
+static Py_ssize_t ArraySample_getSegCount(PyObject *self, Py_ssize_t *lenp)
+{
+  if (lenp) {
+    *lenp = ArraySample_getLength((EA_ArraySample *)self);
+  }
+  return 1;
+}
+
+static Py_ssize_t ArraySample_getCharBuffer(PyObject *self, Py_ssize_t segment,
+                                            char **ptr)
+{
+  return ArraySample_getReadBuffer(self, segment, (void **)ptr);
+}
+
+#if PY_VERSION_HEX >= 0x02060000
+// new style buffer interface, gives numpy and memoryview the shape and type
+static int ArraySample_getBuffer(PyObject *self, Py_buffer *view, int flags)
+{
+  EA_ArraySample *as = (EA_ArraySample *)self;
+  if (PyBuffer_FillInfo(view, self, (void *)as->data,
+                        ArraySample_getLength(as), 1, flags) < 0) {
+    return -1;  // a writable buffer was requested
+  }
+  if ((flags & PyBUF_FORMAT) == PyBUF_FORMAT) {
+    view->format = as->format;
+  }
+  if ((flags & PyBUF_ND) == PyBUF_ND) {
+    view->itemsize = as->itemsize;
+    view->ndim = as->ndim;
+    view->shape = as->shape;
+  }
+  if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) {
+    view->strides = as->strides;
+  }
+  return 0;
+}
+#endif
+
+static PyBufferProcs ArraySample_bufferProcs = {
+    (readbufferproc)ArraySample_getReadBuffer,  // bf_getreadbuffer
+    0,                                          // bf_getwritebuffer
+    (segcountproc)ArraySample_getSegCount,      // bf_getsegcount
+    (charbufferproc)ArraySample_getCharBuffer,  // bf_getcharbuffer
+#if PY_VERSION_HEX >= 0x02060000
+    (getbufferproc)ArraySample_getBuffer,  // bf_getbuffer
+    0,                                     // bf_releasebuffer
+#endif
+};
+
+#if PY_VERSION_HEX >= 0x02060000
+#define ARRAYSAMPLE_TPFLAGS \
+  (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GETCHARBUFFER | Py_TPFLAGS_HAVE_NEWBUFFER)
+#else
+#define ARRAYSAMPLE_TPFLAGS \
+  (Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GETCHARBUFFER)
+#endif
+
+static void ArraySample_delete(PyObject *self)
+{
+  ((EA_ArraySample *)self)->owner.reset();
+  PyObject_FREE(self);
+}
+
+static PyTypeObject ArraySample_Type = {
+    PyObject_HEAD_INIT(&PyType_Type) 0,  // op_size
+    "ArraySample",                       // tp_name
+    sizeof(EA_ArraySample),              // tp_basicsize
+    0,                                   // tp_itemsize
+    (destructor)ArraySample_delete,      // tp_dealloc
+    0,                                   // tp_print
+    0,                                   // tp_getattr
+    0,                                   // tp_setattr
+    0,                                   // tp_compare
+    0,                                   /*tp_repr*/
+    0,                                   /*tp_as_number*/
+    0,                                   /*tp_as_sequence*/
+    0,                                   /*tp_as_mapping*/
+    0,                                   /*tp_hash */
+    0,                                   /*tp_call*/
+    0,                                   /*tp_str*/
+    0,                                   /*tp_getattro*/
+    0,                                   /*tp_setattro*/
+    &ArraySample_bufferProcs,            /*tp_as_buffer*/
+    ARRAYSAMPLE_TPFLAGS,                 /*tp_flags*/
+    "Read-only view on the values of property samples. It supports "
+    "the buffer protocol, so it can be handed to numpy.frombuffer or "
+    "array.array without copying the data.", /* tp_doc */
+};
+
+PyObject *ArraySample_new(const AbcU::shared_ptr<void> &owner,
+                          const void *data, const AbcA::DataType &dataType,
+                          size_t nbElements)
+{
+  const char *format = ArraySample_getFormat(dataType.getPod());
+  if (format == NULL) {
+    PyErr_SetString(getError(),
+                    "String properties can't be accessed as a buffer!");
+    return NULL;
+  }
+
+  EA_ArraySample *as = PyObject_NEW(EA_ArraySample, &ArraySample_Type);
+  if (as == NULL) {
+    return NULL;
+  }
+  new (&(as->owner)) AbcU::shared_ptr<void>(owner);
+  as->data = data;
+
+  const Py_ssize_t extent = (Py_ssize_t)dataType.getExtent();
+  as->format[0] = format[0];
+  as->format[1] = 0;
+  as->itemsize = (Py_ssize_t)AbcA::PODNumBytes(dataType.getPod());
+  as->ndim = extent > 1 ? 2 : 1;
+  as->shape[0] = (Py_ssize_t)nbElements;
+  as->shape[1] = extent;
+  as->strides[0] = extent * as->itemsize;
+  as->strides[1] = as->itemsize;
+  return (PyObject *)as;
+}
+
+PyObject *ArraySample_new(const AbcA::ArraySamplePtr &sample)
+{
+  ALEMBIC_TRY_STATEMENT
+  return ArraySample_new(sample, sample->getData(), sample->getDataType(),
+                         sample->size());
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+PyObject *ArraySample_asBuffer(PyObject *arraySample)
+{
+#if PY_VERSION_HEX >= 0x02070000
+  if (arraySample != NULL) {
+    PyObject *view = PyMemoryView_FromObject(arraySample);
+    Py_DECREF(arraySample);
+    return view;
+  }
+#endif
+  return arraySample;
+}
+
+bool register_object_ArraySample(PyObject *module)
+{
+  return register_object(module, ArraySample_Type, "ArraySample");
+}
@@ -0,0 +1,39 @@
+#ifndef _PYTHON_ALEMBIC_ARRAYSAMPLE_H_
+#define _PYTHON_ALEMBIC_ARRAYSAMPLE_H_
+
+// Read-only view on Alembic values, exposed through the buffer protocol. The
+// object keeps the memory alive (an array sample, or a block built by the
+// extension), so the data is never copied.
+typedef struct {
+  PyObject_HEAD AbcU::shared_ptr<void> owner;
+  const void* data;
+  char format[2];          // struct module format of one component
+  Py_ssize_t itemsize;     // size of one component
+  int ndim;                // 1 for scalar PODs, 2 if the extent is > 1
+  Py_ssize_t shape[2];     // number of elements, extent
+  Py_ssize_t strides[2];
+} EA_ArraySample;
+
+// struct module format of a POD, NULL for strings
+const char* ArraySample_getFormat(AbcA::PlainOldDataType pod);
+
+// true if a buffer item described by format and itemsize holds exactly one
+// component of the POD, the byte order has to be the native one
+bool ArraySample_isFormatOf(AbcA::PlainOldDataType pod, const char* format,
+                            Py_ssize_t itemsize);
+
+// nbElements values of dataType stored at data, which is kept alive by owner.
+// Returns NULL, with an error set, if the POD can't be exposed as a buffer
+// (strings)
+PyObject* ArraySample_new(const AbcU::shared_ptr<void>& owner,
+                          const void* data, const AbcA::DataType& dataType,
+                          size_t nbElements);
+PyObject* ArraySample_new(const AbcA::ArraySamplePtr& sample);
+
+// steals the reference to an ArraySample, and returns a memoryview on it with
+// Python 2.7 or the buffer object itself with older versions
+PyObject* ArraySample_asBuffer(PyObject* arraySample);
+
+bool register_object_ArraySample(PyObject* module);
+
+#endif
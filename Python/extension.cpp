@@ -1,9 +1,14 @@
 #include "stdafx.h"
 
 #include "extension.h"
+#include "archivecompare.h"
+#include "archivecopy.h"
+#include "arraysample.h"
 #include "iarchive.h"
 #include "icompoundproperty.h"
 #include "iobject.h"
+#include "iobjectiterator.h"
+#include "objconvert.h"
 #include "iproperty.h"
 #include "ixformproperty.h"
 #include "oarchive.h"
@@ -93,6 +98,39 @@ static PyMethodDef extension_methods[] = {
      "Appendix B."},
     {"createTimeSampling", (PyCFunction)TimeSampling_new, METH_VARARGS,
      "Returns a new Time Sampling"},
+    {"copyArchives", (PyCFunction)copyArchives, METH_VARARGS | METH_KEYWORDS,
+     "Takes in an iArchive, or a list of iArchives, and an oArchive and copies "
+     "the objects of the inputs into the oArchive, without going through "
+     "Python. Optional keywords: include and exclude, glob patterns ('*' and "
+     "'?') matched against the identifiers, selecting or skipping whole "
+     "subtrees; schema and excludeSchema, glob patterns matched against the "
+     "type of each object (see iObject.getType), selecting or skipping the "
+     "object alone; rename, a tuple (regular expression, format) applied to "
+     "every object name; timeScale and timeOffset, applied to every sample "
+     "time (time * timeScale + timeOffset). With several iArchives, the "
+     "hierarchy of the first one is copied and the samples of the following "
+     "ones are appended, each iArchive starting one sample after the end of "
+     "the previous one. The copied objects aren't known to the oArchive, so "
+     "they can't be retrieved with createObject. Returns the number of "
+     "objects copied."},
+    {"compareArchives", (PyCFunction)compareArchives,
+     METH_VARARGS | METH_KEYWORDS,
+     "Takes in two iArchives and compares their hierarchies, metadata, time "
+     "samplings and samples. Array samples are compared on their digests; "
+     "with the optional epsilon keyword, the floating point samples whose "
+     "digests differ are read and compared within epsilon. Returns a list of "
+     "(identifier, kind, description) tuples, one per difference, where kind "
+     "is one of 'missing', 'type', 'metaData', 'timeSampling', 'nbSamples' or "
+     "'values'. The list is empty if the archives are identical."},
+    {"convertOBJ", (PyCFunction)convertOBJ, METH_VARARGS | METH_KEYWORDS,
+     "Takes in an OBJ file name, or a list of OBJ file names for an animated "
+     "sequence, and an oArchive, and writes the OBJ geometry as a PolyMesh. "
+     "Positions, faces, texture coordinates and normals are read; UVs and "
+     "normals are written face-varying and indexed. Optional keywords: "
+     "identifier, the identifier of the PolyMesh (default '/pFromObj'), its "
+     "parent has to be the top or an object created with createObject; fps, "
+     "the frame rate of a sequence (default 24). The PolyMesh isn't known to "
+     "the oArchive. Returns the number of frames written."},
     {NULL, NULL}};
 
 static PyMethodDef unlicensed_extension_methods[] = {{NULL, NULL}};
@@ -116,11 +154,23 @@ EXTENSION_CALLBACK init_ExocortexAlembicPython(void)
   PyObject* m =
       Py_InitModule3("_ExocortexAlembicPython", extension_methods,
                      "This is the core extension module. It provides access to "
-                     "input as well as output archive objects.");
+                     "input as well as output archive objects.\n\n"
+                     "Threads: the interpreter lock is released while samples "
+                     "are read or written, archives opened or closed and "
+                     "hierarchies walked. iArchives, and the objects and "
+                     "properties they return, can be used from several "
+                     "threads at once; reads of Ogawa archives are not "
+                     "serialized by the extension, reads of HDF5 archives "
+                     "are. An oArchive, with its objects and properties, must "
+                     "only be used by one thread at a time.");
   PyObject* d = PyModule_GetDict(m);
 
+  // the extension releases the interpreter lock around Alembic I/O
+  PyEval_InitThreads();
+
   bool reg = register_object_iArchive(m);
   reg = reg && register_object_iObject(m);
+  reg = reg && register_object_iObjectIterator(m);
   reg = reg && register_object_iProperty(m);
   reg = reg && register_object_iCompoundProperty(m);
   reg = reg && register_object_iXformProperty(m);
@@ -132,6 +182,7 @@ EXTENSION_CALLBACK init_ExocortexAlembicPython(void)
   reg = reg && register_object_oXformProperty(m);
 
   reg = reg && register_object_TS(m);
+  reg = reg && register_object_ArraySample(m);
 
   if (!reg) {
     printf("Fail to register all objects\n");
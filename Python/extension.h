@@ -21,4 +21,29 @@ PyObject *getError();
 bool register_object(PyObject *module, PyTypeObject &type_object,
                      const char *object_name);
 
+// Releases the interpreter lock for the lifetime of the object, so that other
+// Python threads keep running while Alembic reads, decompresses or writes.
+// No Python object may be touched in that scope. HDF5 isn't thread safe, so
+// calls into HDF5 archives pass release = false: the interpreter lock then
+// keeps serializing them with every other HDF5 call of the extension.
+class allowThreads {
+ public:
+  explicit allowThreads(bool release)
+      : mState(release ? PyEval_SaveThread() : NULL)
+  {
+  }
+  ~allowThreads()
+  {
+    if (mState) {
+      PyEval_RestoreThread(mState);
+    }
+  }
+
+ private:
+  allowThreads(const allowThreads &);
+  allowThreads &operator=(const allowThreads &);
+
+  PyThreadState *mState;
+};
+
 #endif
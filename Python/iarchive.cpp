@@ -2,8 +2,10 @@
 
 #include "iarchive.h"
 #include "AlembicLicensing.h"
+#include "arraysample.h"
 #include "extension.h"
 #include "iobject.h"
+#include "iobjectiterator.h"
 #include "oarchive.h"
 #include "timesampling.h"
 
@@ -25,6 +27,14 @@ static bool setIArchiveClosed(std::string filename)
   return iArchive_filenames.erase(filename) == 1;
 }
 
+// archives read with Ogawa, which is thread safe unlike HDF5
+static str_set iArchive_ogawaFilenames;
+bool isIArchiveOgawa(std::string filename)
+{
+  return iArchive_ogawaFilenames.find(filename) !=
+         iArchive_ogawaFilenames.end();
+}
+
 size_t gNbIArchives = 0;
 size_t getNbIArchives() { return gNbIArchives; }
 static PyObject *iArchive_getFileName(PyObject *self, PyObject *args)
@@ -44,18 +54,14 @@ static PyObject *iArchive_getVersion(PyObject *self, PyObject *args)
 }
 
 #include <string>
-static void recurseObjectChildren(PyObject *list, const Abc::IObject &obj)
+static void recurseObjectChildren(std::vector<std::string> &names,
+                                  const Abc::IObject &obj)
 {
   const int nbChildren = obj.getNumChildren();
   for (int i = 0; i < nbChildren; ++i) {
     const Abc::IObject child = obj.getChild(i);
-    const std::string fullName = child.getFullName();
-
-    PyObject *item =
-        PyString_FromStringAndSize(fullName.c_str(), fullName.size());
-    PyList_Append(list, item);
-
-    recurseObjectChildren(list, child);
+    names.push_back(child.getFullName());
+    recurseObjectChildren(names, child);
   }
 }
 
@@ -65,9 +71,18 @@ static PyObject *iArchive_getIdentifiers(PyObject *self, PyObject *args)
 
   iArchive *archive = (iArchive *)self;
 
-  PyObject *list = PyList_New(0);
-  recurseObjectChildren(list, archive->mArchive->getTop());
+  // walk the hierarchy without the interpreter lock, then build the list
+  std::vector<std::string> names;
+  {
+    allowThreads threads(archive->oType == AbcF::IFactory::kOgawa);
+    recurseObjectChildren(names, archive->mArchive->getTop());
+  }
 
+  PyObject *list = PyList_New(names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    PyList_SET_ITEM(list, i, PyString_FromStringAndSize(names[i].c_str(),
+                                                        names[i].size()));
+  }
   return list;
 
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
@@ -108,6 +123,193 @@ static PyObject *iArchive_getObject(PyObject *self, PyObject *args)
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
+static PyObject *iArchive_iterObjects(PyObject *self, PyObject *args,
+                                      PyObject *kwds)
+{
+  ALEMBIC_TRY_STATEMENT
+  static char *kwlist[] = {(char *)"glob", (char *)"regex", (char *)"schema",
+                           (char *)"maxDepth", NULL};
+
+  char *glob = NULL, *regex = NULL, *schema = NULL;
+  int maxDepth = -1;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "|zzzi", kwlist, &glob, &regex,
+                                   &schema, &maxDepth)) {
+    PyErr_SetString(getError(),
+                    "Invalid filters, glob, regex and schema should be "
+                    "strings and maxDepth an integer!");
+    return NULL;
+  }
+
+  objectFilter filter;
+  if (glob) {
+    filter.glob = glob;
+  }
+  if (schema) {
+    filter.schema = schema;
+  }
+  filter.maxDepth = maxDepth;
+  if (regex) {
+    try {
+      filter.regex.assign(regex);
+    }
+    catch (std::exception &) {
+      PyErr_SetString(getError(), "Invalid regular expression!");
+      return NULL;
+    }
+    filter.useRegex = true;
+  }
+
+  iArchive *archive = (iArchive *)self;
+  return iObjectIterator_new(self, archive->mArchive->getTop(),
+                             new objectFilter(filter));
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+AbcArchiveCache *iArchive_getCache(iArchive *archive)
+{
+  if (archive->mCache) {
+    return archive->mCache;
+  }
+
+  // every object is visited and the meshes are scanned, without the lock
+  AbcArchiveCache *cache = new AbcArchiveCache();
+  bool built = false;
+  {
+    allowThreads threads(archive->oType == AbcF::IFactory::kOgawa);
+    built = createAbcArchiveCache(archive->mArchive, cache);
+  }
+  if (!built) {
+    delete cache;
+    PyErr_SetString(getError(), "Can't build the archive summary!");
+    return NULL;
+  }
+
+  // another thread may have built it meanwhile
+  if (archive->mCache) {
+    allowThreads threads(archive->oType == AbcF::IFactory::kOgawa);
+    delete cache;
+  }
+  else {
+    archive->mCache = cache;
+  }
+  return archive->mCache;
+}
+
+template <typename T>
+static PyObject *iArchive_newSummaryBuffer(
+    const AbcU::shared_ptr<std::vector<T> > &values,
+    AbcA::PlainOldDataType pod)
+{
+  return ArraySample_asBuffer(
+      ArraySample_new(values, values->empty() ? NULL : &(*values)[0],
+                      AbcA::DataType(pod, 1), values->size()));
+}
+
+static PyObject *iArchive_newSummaryList(
+    const std::vector<std::string> &strings)
+{
+  PyObject *list = PyList_New(strings.size());
+  if (list == NULL) {
+    return NULL;
+  }
+  for (size_t i = 0; i < strings.size(); ++i) {
+    PyObject *str = PyString_FromString(strings[i].c_str());
+    if (str == NULL) {
+      Py_DECREF(list);
+      return NULL;
+    }
+    PyList_SET_ITEM(list, i, str);
+  }
+  return list;
+}
+
+static PyObject *iArchive_getSummary(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  iArchive *archive = (iArchive *)self;
+  AbcArchiveCache *cache = iArchive_getCache(archive);
+  if (cache == NULL) {
+    return NULL;
+  }
+
+  // the cache is sorted on the identifiers, so parents come first
+  const size_t nbObjects = cache->size();
+  std::map<std::string, int> indices;
+  AbcU::shared_ptr<std::vector<AbcU::int32_t> > parents(
+      new std::vector<AbcU::int32_t>(nbObjects));
+  AbcU::shared_ptr<std::vector<AbcU::int32_t> > numSamples(
+      new std::vector<AbcU::int32_t>(nbObjects));
+  AbcU::shared_ptr<std::vector<AbcU::uint8_t> > isConstant(
+      new std::vector<AbcU::uint8_t>(nbObjects));
+  AbcU::shared_ptr<std::vector<AbcU::uint8_t> > isMeshPointCache(
+      new std::vector<AbcU::uint8_t>(nbObjects));
+  AbcU::shared_ptr<std::vector<AbcU::uint8_t> > isMeshTopoDynamic(
+      new std::vector<AbcU::uint8_t>(nbObjects));
+  size_t i = 0;
+  std::vector<std::string> identifiers, types;
+  identifiers.reserve(nbObjects);
+  types.reserve(nbObjects);
+  for (AbcArchiveCache::const_iterator it = cache->begin(); it != cache->end();
+       ++it, ++i) {
+    const AbcObjectCache &objectCache = it->second;
+    indices[it->first] = (int)i;
+
+    std::map<std::string, int>::const_iterator parent =
+        indices.find(objectCache.parentIdentifier);
+    (*parents)[i] = parent == indices.end() ? -1 : parent->second;
+    (*numSamples)[i] = objectCache.numSamples;
+    (*isConstant)[i] = objectCache.isConstant;
+    (*isMeshPointCache)[i] = objectCache.isMeshPointCache;
+    (*isMeshTopoDynamic)[i] = objectCache.isMeshTopoDynamic;
+    identifiers.push_back(it->first);
+    types.push_back(objectCache.obj.getMetaData().get("schema"));
+  }
+
+  // each value is checked as it is built, so none leaks on a failure
+  enum { NB_VALUES = 7 };
+  PyObject *values[NB_VALUES] = {NULL};
+  int nbBuilt = 0;
+  for (; nbBuilt < NB_VALUES; ++nbBuilt) {
+    PyObject *&value = values[nbBuilt];
+    switch (nbBuilt) {
+      case 0:
+        value = iArchive_newSummaryList(identifiers);
+        break;
+      case 1:
+        value = iArchive_newSummaryList(types);
+        break;
+      case 2:
+        value = iArchive_newSummaryBuffer(parents, AbcA::kInt32POD);
+        break;
+      case 3:
+        value = iArchive_newSummaryBuffer(numSamples, AbcA::kInt32POD);
+        break;
+      case 4:
+        value = iArchive_newSummaryBuffer(isConstant, AbcA::kBooleanPOD);
+        break;
+      case 5:
+        value = iArchive_newSummaryBuffer(isMeshPointCache, AbcA::kBooleanPOD);
+        break;
+      default:
+        value = iArchive_newSummaryBuffer(isMeshTopoDynamic, AbcA::kBooleanPOD);
+        break;
+    }
+    if (value == NULL) {
+      for (int v = 0; v < nbBuilt; ++v) {
+        Py_DECREF(values[v]);
+      }
+      return NULL;
+    }
+  }
+
+  return Py_BuildValue("{s:N,s:N,s:N,s:N,s:N,s:N,s:N}", "identifiers",
+                       values[0], "types", values[1], "parents", values[2],
+                       "numSamples", values[3], "isConstant", values[4],
+                       "isMeshPointCache", values[5], "isMeshTopoDynamic",
+                       values[6]);
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
 static PyObject *iArchive_getSampleTimes(PyObject *self, PyObject *args)
 {
   ALEMBIC_TRY_STATEMENT
@@ -151,11 +353,26 @@ static PyMethodDef iArchive_methods[] = {
      "Returns a flat string list of all of the identifiers available."},
     {"getObject", (PyCFunction)iArchive_getObject, METH_VARARGS,
      "Returns an iObject for the provided identifier string."},
+    {"iterObjects", (PyCFunction)iArchive_iterObjects,
+     METH_VARARGS | METH_KEYWORDS,
+     "Returns an iterator over the iObjects of the archive, depth first. "
+     "Objects are only read as the iteration goes. Optional filters: glob, a "
+     "pattern ('*' and '?') matched against the identifier; regex, a regular "
+     "expression searched in the identifier; schema, a pattern matched "
+     "against the type (see iObject.getType); maxDepth, the number of levels "
+     "visited below the top, all of them by default."},
     {"getSampleTimes", (PyCFunction)iArchive_getSampleTimes, METH_NOARGS,
      "Returns a two dimensional array of all TimeSamplings available in this "
      "file."},
     {"getCoreType", (PyCFunction)iArchive_getCoreType, METH_NOARGS,
      "Returns the core used by the archive (HDF5, Ogawa, or Unknown)."},
+    {"getSummary", (PyCFunction)iArchive_getSummary, METH_NOARGS,
+     "Returns a summary of every object of the archive, as a dictionary of "
+     "parallel arrays sorted on the identifiers: 'identifiers' and 'types' "
+     "(lists of strings), 'parents' (index of the parent object, -1 for the "
+     "top), 'numSamples', 'isConstant', 'isMeshPointCache' and "
+     "'isMeshTopoDynamic' (buffers). The summary is computed once, the first "
+     "time it's requested."},
     {NULL, NULL}};
 
 static PyObject *iArchive_getAttr(PyObject *self, char *attrName)
@@ -171,8 +388,13 @@ static void iArchive_delete(PyObject *self)
 
   // NEW, remove the filename from the list
   setIArchiveClosed(object->mArchive->getName());
+  iArchive_ogawaFilenames.erase(object->mArchive->getName());
 
-  delete (object->mArchive);
+  {
+    allowThreads threads(object->oType == AbcF::IFactory::kOgawa);
+    delete (object->mCache);
+    delete (object->mArchive);
+  }
   PyObject_FREE(object);
   gNbIArchives--;
   ALEMBIC_VOID_CATCH_STATEMENT
@@ -234,26 +456,42 @@ PyObject *iArchive_new(PyObject *self, PyObject *args)
     return NULL;
   }
 
-  // check if the filename exists
+  // check if the filename exists, and if it's an Ogawa archive
   FILE *file = fopen(fileName, "rb");
   if (file == NULL) {
     PyErr_SetString(getError(), "File does not exist!");
     return NULL;
   }
+  char magic[5];
+  const bool isOgawa =
+      fread(magic, 1, 5, file) == 5 && memcmp(magic, "Ogawa", 5) == 0;
   fclose(file);
 
   iArchive *object = PyObject_NEW(iArchive, &iArchive_Type);
   if (object != NULL) {
-    AbcF::IFactory iFactory;
-    object->mArchive =
-        new Abc::IArchive(iFactory.getArchive(fileName, object->oType));
+    object->mArchive = NULL;
+    object->mCache = NULL;
+    {
+      allowThreads threads(isOgawa);
+      AbcF::IFactory iFactory;
+      object->mArchive =
+          new Abc::IArchive(iFactory.getArchive(fileName, object->oType));
+    }
     setIArchiveOpened(fileName);
+    if (object->oType == AbcF::IFactory::kOgawa) {
+      iArchive_ogawaFilenames.insert(fileName);
+    }
     gNbIArchives++;
   }
   return (PyObject *)object;
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
+bool PyObject_iArchive_Check(PyObject *obj)
+{
+  return obj->ob_type == &iArchive_Type;
+}
+
 bool register_object_iArchive(PyObject *module)
 {
   return register_object(module, iArchive_Type, "iArchive");
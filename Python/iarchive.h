@@ -1,17 +1,25 @@
 #ifndef _PYTHON_ALEMBIC_IARCHIVE_H_
 #define _PYTHON_ALEMBIC_IARCHIVE_H_
 
+#include "CommonAbcCache.h"
 #include "CommonAlembic.h"
 
 typedef struct {
   PyObject_HEAD Abc::IArchive *mArchive;
   AbcF::IFactory::CoreType oType;
+  AbcArchiveCache *mCache;  // summary of every object, built on demand
 } iArchive;
 
 PyObject *iArchive_new(PyObject *self, PyObject *args);
 size_t getNbIArchives();
 bool isIArchiveOpened(std::string filename);
+bool isIArchiveOgawa(std::string filename);
 
+// the shared archive cache of an iArchive, built the first time it's needed.
+// Returns NULL, with an error set, if it can't be built
+AbcArchiveCache *iArchive_getCache(iArchive *archive);
+
+bool PyObject_iArchive_Check(PyObject *obj);
 bool register_object_iArchive(PyObject *module);
 
 #endif
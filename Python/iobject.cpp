@@ -62,7 +62,12 @@ static PyObject *iObject_getMetaData(PyObject *self, PyObject *args)
 
   Abc::IStringArrayProperty metaDataProp =
       Abc::IStringArrayProperty(compound, ".metadata");
-  Abc::StringArraySamplePtr metaDataPtr = metaDataProp.getValue(0);
+  Abc::StringArraySamplePtr metaDataPtr;
+  {
+    allowThreads threads(
+        isIArchiveOgawa(object->mObject->getArchive().getName()));
+    metaDataPtr = metaDataProp.getValue(0);
+  }
 
   PyObject *tuple = PyTuple_New(20);  // needs to be exactly 20
   size_t i = 0;
@@ -173,6 +178,38 @@ static PyObject *iObject_getTsIndex(PyObject *self, PyObject *args)
   return Py_BuildValue("i", (int)obj->tsIndex);
 }
 
+static PyObject *iObject_getSummary(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  iObject *object = (iObject *)self;
+  AbcArchiveCache *cache = iArchive_getCache((iArchive *)object->mArchive);
+  if (cache == NULL) {
+    return NULL;
+  }
+  AbcArchiveCache::const_iterator it =
+      cache->find(object->mObject->getFullName());
+  if (it == cache->end()) {
+    PyErr_SetString(getError(), "Object not found in the archive summary!");
+    return NULL;
+  }
+
+  const AbcObjectCache &objectCache = it->second;
+  PyObject *children = PyList_New(objectCache.childIdentifiers.size());
+  for (size_t i = 0; i < objectCache.childIdentifiers.size(); ++i) {
+    PyList_SET_ITEM(children, i,
+                    PyString_FromString(objectCache.childIdentifiers[i].c_str()));
+  }
+  return Py_BuildValue(
+      "{s:s,s:s,s:N,s:i,s:N,s:N,s:N}", "identifier",
+      objectCache.fullName.c_str(), "parent",
+      objectCache.parentIdentifier.c_str(), "children", children,
+      "numSamples", objectCache.numSamples, "isConstant",
+      PyBool_FromLong(objectCache.isConstant), "isMeshPointCache",
+      PyBool_FromLong(objectCache.isMeshPointCache), "isMeshTopoDynamic",
+      PyBool_FromLong(objectCache.isMeshTopoDynamic));
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
 static PyMethodDef iObject_methods[] = {
     {"getIdentifier", (PyCFunction)iObject_getIdentifier, METH_NOARGS,
      "Returns the identifier linked to this object."},
@@ -193,6 +230,11 @@ static PyMethodDef iObject_methods[] = {
      "for the given propertyName string."},
     {"getTsIndex", (PyCFunction)iObject_getTsIndex, METH_NOARGS,
      "Returns time sampling index used by this object."},
+    {"getSummary", (PyCFunction)iObject_getSummary, METH_NOARGS,
+     "Returns the summary of this object from the archive summary, as a "
+     "dictionary: identifier, parent, children (list of identifiers), "
+     "numSamples, isConstant, isMeshPointCache and isMeshTopoDynamic. See "
+     "iArchive.getSummary."},
     {NULL, NULL}};
 static PyObject *iObject_getAttr(PyObject *self, char *attrName)
 {
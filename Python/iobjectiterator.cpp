@@ -0,0 +1,136 @@
+#include "stdafx.h"
+
+#include "iobjectiterator.h"
+#include "extension.h"
+#include "iobject.h"
+
+// depth first walk, only the objects that match the filter or have to be
+// descended into are opened
+static bool iObjectIterator_findNext(iObjectIteratorStack &stack,
+                                     const objectFilter &filter,
+                                     Abc::IObject &found)
+{
+  while (!stack.empty()) {
+    Abc::IObject parent = stack.back().object;
+    const size_t index = stack.back().nextChild;
+    if (index >= parent.getNumChildren()) {
+      stack.pop_back();
+      continue;
+    }
+    stack.back().nextChild++;
+
+    // the children are only visited when their parent is above maxDepth
+    const int depth = (int)stack.size();
+    if (!filter.descends(depth - 1)) {
+      stack.pop_back();
+      continue;
+    }
+    const bool match = filter.matches(parent.getChildHeader(index));
+    const bool descend = filter.descends(depth);
+    if (!match && !descend) {
+      continue;
+    }
+
+    Abc::IObject child = parent.getChild(index);
+    if (descend) {
+      iObjectIteratorLevel level;
+      level.object = child;
+      level.nextChild = 0;
+      stack.push_back(level);
+    }
+    if (match) {
+      found = child;
+      return true;
+    }
+  }
+  return false;
+}
+
+static PyObject *iObjectIterator_next(PyObject *self)
+{
+  ALEMBIC_TRY_STATEMENT
+  iObjectIterator *iterator = (iObjectIterator *)self;
+  Abc::IObject found;
+  if (!iObjectIterator_findNext(*iterator->mStack, *iterator->mFilter,
+                                found)) {
+    return NULL;  // no exception set, stops the iteration
+  }
+  return iObject_new(found, iterator->mArchive);
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+static PyMethodDef iObjectIterator_methods[] = {{NULL, NULL}};
+
+static PyObject *iObjectIterator_getAttr(PyObject *self, char *attrName)
+{
+  return Py_FindMethod(iObjectIterator_methods, self, attrName);
+}
+
+static void iObjectIterator_delete(PyObject *self)
+{
+  ALEMBIC_TRY_STATEMENT
+  iObjectIterator *iterator = (iObjectIterator *)self;
+  delete iterator->mStack;
+  delete iterator->mFilter;
+  Py_XDECREF(iterator->mArchive);
+  PyObject_FREE(iterator);
+  ALEMBIC_VOID_CATCH_STATEMENT
+}
+
+static PyTypeObject iObjectIterator_Type = {
+    PyObject_HEAD_INIT(&PyType_Type) 0,     // op_size
+    "iObjectIterator",                      // tp_name
+    sizeof(iObjectIterator),                // tp_basicsize
+    0,                                      // tp_itemsize
+    (destructor)iObjectIterator_delete,     // tp_dealloc
+    0,                                      // tp_print
+    (getattrfunc)iObjectIterator_getAttr,   // tp_getattr
+    0,                                      // tp_setattr
+    0,                                      // tp_compare
+    0,                                      /*tp_repr*/
+    0,                                      /*tp_as_number*/
+    0,                                      /*tp_as_sequence*/
+    0,                                      /*tp_as_mapping*/
+    0,                                      /*tp_hash */
+    0,                                      /*tp_call*/
+    0,                                      /*tp_str*/
+    0,                                      /*tp_getattro*/
+    0,                                      /*tp_setattro*/
+    0,                                      /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,                     /*tp_flags*/
+    "Iterates lazily over the objects of an iArchive, depth first, and "
+    "yields the iObjects matching its filters.", /* tp_doc */
+    0,                                           /* tp_traverse */
+    0,                                           /* tp_clear */
+    0,                                           /* tp_richcompare */
+    0,                                           /* tp_weaklistoffset */
+    PyObject_SelfIter,                           /* tp_iter */
+    (iternextfunc)iObjectIterator_next,          /* tp_iternext */
+    iObjectIterator_methods,                     /* tp_methods */
+};
+
+PyObject *iObjectIterator_new(PyObject *archive, const Abc::IObject &root,
+                              objectFilter *filter)
+{
+  ALEMBIC_TRY_STATEMENT
+  iObjectIterator *iterator =
+      PyObject_NEW(iObjectIterator, &iObjectIterator_Type);
+  if (iterator == NULL) {
+    delete filter;
+    return NULL;
+  }
+
+  Py_INCREF(archive);
+  iterator->mArchive = archive;
+  iterator->mFilter = filter;
+  iterator->mStack = new iObjectIteratorStack(1);
+  iterator->mStack->back().object = root;
+  iterator->mStack->back().nextChild = 0;
+  return (PyObject *)iterator;
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+bool register_object_iObjectIterator(PyObject *module)
+{
+  return register_object(module, iObjectIterator_Type, "iObjectIterator");
+}
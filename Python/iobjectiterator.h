@@ -0,0 +1,25 @@
+#ifndef _PYTHON_ALEMBIC_IOBJECTITERATOR_H_
+#define _PYTHON_ALEMBIC_IOBJECTITERATOR_H_
+
+#include "objectfilter.h"
+
+struct iObjectIteratorLevel {
+  Abc::IObject object;
+  size_t nextChild;
+};
+
+typedef std::vector<iObjectIteratorLevel> iObjectIteratorStack;
+
+typedef struct {
+  PyObject_HEAD PyObject *mArchive;  // the iArchive, kept alive while iterating
+  iObjectIteratorStack *mStack;      // the objects being visited, top first
+  objectFilter *mFilter;
+} iObjectIterator;
+
+// takes ownership of filter
+PyObject *iObjectIterator_new(PyObject *archive, const Abc::IObject &root,
+                              objectFilter *filter);
+
+bool register_object_iObjectIterator(PyObject *module);
+
+#endif
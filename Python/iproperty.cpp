@@ -3,7 +3,9 @@
 #include "iproperty.h"
 #include "AlembicLicensing.h"
 #include "CommonUtilities.h"
+#include "arraysample.h"
 #include "extension.h"
+#include "iarchive.h"
 #include "icompoundproperty.h"  // to call iCompoundProperty_new in iProperty_new if it's an iCompoundProperty
 #include "iobject.h"
 #include "timesampling.h"
@@ -390,10 +392,17 @@ static PyObject *iProperty_getNbStoredSamples(PyObject *self, PyObject *args)
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
+// array samples are read and decompressed without the interpreter lock
+#define _GET_ARRAY_SAMPLE_(mXArrayProperty)          \
+  {                                                  \
+    allowThreads threads(prop->mAllowThreads);       \
+    prop->mXArrayProperty->get(sample, sampleIndex); \
+  }
+
 #define _GET_SIZE_CASE_IMPL_(tp, base, arrayprop)            \
   case tp: {                                                 \
     Abc::I##base##arrayprop::sample_ptr_type sample;         \
-    prop->m##base##arrayprop->get(sample, sampleIndex);      \
+    _GET_ARRAY_SAMPLE_(m##base##arrayprop);                  \
     return Py_BuildValue("I", (unsigned int)sample->size()); \
   }
 #define _GET_SIZE_CASE_(tp, base) _GET_SIZE_CASE_IMPL_(tp, base, ArrayProperty)
@@ -487,12 +496,12 @@ static PyObject *iProperty_getSize(PyObject *self, PyObject *args)
 #define _GET_VALUE_INTENT(mXProperty, AlembicType, python_cast, cast_type)   \
   if (prop->intent > 1) {                                                    \
     tuple = PyTuple_New(prop->intent);                                       \
-    AlembicType *values = new AlembicType[prop->intent];                     \
+    /* the extent is stored on 8 bits */                                     \
+    AlembicType values[256];                                                 \
     prop->mBaseScalarProperty->get(values, sampleIndex);                     \
     for (int i = 0; i < prop->intent; ++i)                                   \
       PyTuple_SetItem(tuple, i,                                              \
                       Py_BuildValue(python_cast, (cast_type)values[i]));     \
-    delete[] values;                                                         \
   }                                                                          \
   else {                                                                     \
     tuple = PyTuple_New(1);                                                  \
@@ -1072,7 +1081,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_boolean_array: {
       Abc::IBoolArrayProperty::sample_ptr_type sample;
       Abc::IBoolArrayProperty::value_type value;
-      prop->mBoolArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBoolArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1091,7 +1100,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_uchar_array: {
       Abc::IUcharArrayProperty::sample_ptr_type sample;
       Abc::IUcharArrayProperty::value_type value;
-      prop->mUcharArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mUcharArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1111,7 +1120,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_char_array: {
       Abc::ICharArrayProperty::sample_ptr_type sample;
       Abc::ICharArrayProperty::value_type value;
-      prop->mCharArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mCharArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1130,7 +1139,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_uint16_array: {
       Abc::IUInt16ArrayProperty::sample_ptr_type sample;
       Abc::IUInt16ArrayProperty::value_type value;
-      prop->mUInt16ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mUInt16ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1150,7 +1159,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_int16_array: {
       Abc::IInt16ArrayProperty::sample_ptr_type sample;
       Abc::IInt16ArrayProperty::value_type value;
-      prop->mInt16ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mInt16ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1169,7 +1178,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_uint32_array: {
       Abc::IUInt32ArrayProperty::sample_ptr_type sample;
       Abc::IUInt32ArrayProperty::value_type value;
-      prop->mUInt32ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mUInt32ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1189,7 +1198,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_int32_array: {
       Abc::IInt32ArrayProperty::sample_ptr_type sample;
       Abc::IInt32ArrayProperty::value_type value;
-      prop->mInt32ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mInt32ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1208,7 +1217,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_uint64_array: {
       Abc::IUInt64ArrayProperty::sample_ptr_type sample;
       Abc::IUInt64ArrayProperty::value_type value;
-      prop->mUInt64ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mUInt64ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1228,7 +1237,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_int64_array: {
       Abc::IInt64ArrayProperty::sample_ptr_type sample;
       Abc::IInt64ArrayProperty::value_type value;
-      prop->mInt64ArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mInt64ArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1248,7 +1257,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_half_array: {
       Abc::IHalfArrayProperty::sample_ptr_type sample;
       Abc::IHalfArrayProperty::value_type value;
-      prop->mHalfArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mHalfArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1267,7 +1276,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_float_array: {
       Abc::IFloatArrayProperty::sample_ptr_type sample;
       Abc::IFloatArrayProperty::value_type value;
-      prop->mFloatArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mFloatArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1286,7 +1295,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_double_array: {
       Abc::IDoubleArrayProperty::sample_ptr_type sample;
       Abc::IDoubleArrayProperty::value_type value;
-      prop->mDoubleArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mDoubleArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1305,7 +1314,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_string_array: {
       Abc::IStringArrayProperty::sample_ptr_type sample;
       Abc::IStringArrayProperty::value_type value;
-      prop->mStringArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mStringArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1324,7 +1333,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_wstring_array: {
       Abc::IWstringArrayProperty::sample_ptr_type sample;
       Abc::IWstringArrayProperty::value_type value;
-      prop->mWstringArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mWstringArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1343,7 +1352,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v2s_array: {
       Abc::IV2sArrayProperty::sample_ptr_type sample;
       Abc::IV2sArrayProperty::value_type value;
-      prop->mV2sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV2sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1363,7 +1372,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v2i_array: {
       Abc::IV2iArrayProperty::sample_ptr_type sample;
       Abc::IV2iArrayProperty::value_type value;
-      prop->mV2iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV2iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1383,7 +1392,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v2f_array: {
       Abc::IV2fArrayProperty::sample_ptr_type sample;
       Abc::IV2fArrayProperty::value_type value;
-      prop->mV2fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV2fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1403,7 +1412,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v2d_array: {
       Abc::IV2dArrayProperty::sample_ptr_type sample;
       Abc::IV2dArrayProperty::value_type value;
-      prop->mV2dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV2dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1423,7 +1432,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v3s_array: {
       Abc::IV3sArrayProperty::sample_ptr_type sample;
       Abc::IV3sArrayProperty::value_type value;
-      prop->mV3sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV3sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1444,7 +1453,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v3i_array: {
       Abc::IV3iArrayProperty::sample_ptr_type sample;
       Abc::IV3iArrayProperty::value_type value;
-      prop->mV3iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV3iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1465,7 +1474,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v3f_array: {
       Abc::IV3fArrayProperty::sample_ptr_type sample;
       Abc::IV3fArrayProperty::value_type value;
-      prop->mV3fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV3fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1486,7 +1495,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_v3d_array: {
       Abc::IV3dArrayProperty::sample_ptr_type sample;
       Abc::IV3dArrayProperty::value_type value;
-      prop->mV3dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mV3dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1507,7 +1516,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p2s_array: {
       Abc::IP2sArrayProperty::sample_ptr_type sample;
       Abc::IP2sArrayProperty::value_type value;
-      prop->mP2sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP2sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1527,7 +1536,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p2i_array: {
       Abc::IP2iArrayProperty::sample_ptr_type sample;
       Abc::IP2iArrayProperty::value_type value;
-      prop->mP2iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP2iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1547,7 +1556,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p2f_array: {
       Abc::IP2fArrayProperty::sample_ptr_type sample;
       Abc::IP2fArrayProperty::value_type value;
-      prop->mP2fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP2fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1567,7 +1576,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p2d_array: {
       Abc::IP2dArrayProperty::sample_ptr_type sample;
       Abc::IP2dArrayProperty::value_type value;
-      prop->mP2dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP2dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1587,7 +1596,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p3s_array: {
       Abc::IP3sArrayProperty::sample_ptr_type sample;
       Abc::IP3sArrayProperty::value_type value;
-      prop->mP3sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP3sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1608,7 +1617,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p3i_array: {
       Abc::IP3iArrayProperty::sample_ptr_type sample;
       Abc::IP3iArrayProperty::value_type value;
-      prop->mP3iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP3iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1629,7 +1638,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p3f_array: {
       Abc::IP3fArrayProperty::sample_ptr_type sample;
       Abc::IP3fArrayProperty::value_type value;
-      prop->mP3fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP3fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1650,7 +1659,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_p3d_array: {
       Abc::IP3dArrayProperty::sample_ptr_type sample;
       Abc::IP3dArrayProperty::value_type value;
-      prop->mP3dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mP3dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1671,7 +1680,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box2s_array: {
       Abc::IBox2sArrayProperty::sample_ptr_type sample;
       Abc::IBox2sArrayProperty::value_type value;
-      prop->mBox2sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox2sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1697,7 +1706,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box2i_array: {
       Abc::IBox2iArrayProperty::sample_ptr_type sample;
       Abc::IBox2iArrayProperty::value_type value;
-      prop->mBox2iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox2iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1723,7 +1732,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box2f_array: {
       Abc::IBox2fArrayProperty::sample_ptr_type sample;
       Abc::IBox2fArrayProperty::value_type value;
-      prop->mBox2fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox2fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1745,7 +1754,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box2d_array: {
       Abc::IBox2dArrayProperty::sample_ptr_type sample;
       Abc::IBox2dArrayProperty::value_type value;
-      prop->mBox2dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox2dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1767,7 +1776,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box3s_array: {
       Abc::IBox3sArrayProperty::sample_ptr_type sample;
       Abc::IBox3sArrayProperty::value_type value;
-      prop->mBox3sArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox3sArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1797,7 +1806,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box3i_array: {
       Abc::IBox3iArrayProperty::sample_ptr_type sample;
       Abc::IBox3iArrayProperty::value_type value;
-      prop->mBox3iArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox3iArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1827,7 +1836,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box3f_array: {
       Abc::IBox3fArrayProperty::sample_ptr_type sample;
       Abc::IBox3fArrayProperty::value_type value;
-      prop->mBox3fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox3fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1851,7 +1860,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_box3d_array: {
       Abc::IBox3dArrayProperty::sample_ptr_type sample;
       Abc::IBox3dArrayProperty::value_type value;
-      prop->mBox3dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mBox3dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1875,7 +1884,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_m33f_array: {
       Abc::IM33fArrayProperty::sample_ptr_type sample;
       Abc::IM33fArrayProperty::value_type value;
-      prop->mM33fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mM33fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1902,7 +1911,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_m33d_array: {
       Abc::IM33dArrayProperty::sample_ptr_type sample;
       Abc::IM33dArrayProperty::value_type value;
-      prop->mM33dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mM33dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1929,7 +1938,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_m44f_array: {
       Abc::IM44fArrayProperty::sample_ptr_type sample;
       Abc::IM44fArrayProperty::value_type value;
-      prop->mM44fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mM44fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1963,7 +1972,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_m44d_array: {
       Abc::IM44dArrayProperty::sample_ptr_type sample;
       Abc::IM44dArrayProperty::value_type value;
-      prop->mM44dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mM44dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -1997,7 +2006,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_quatf_array: {
       Abc::IQuatfArrayProperty::sample_ptr_type sample;
       Abc::IQuatfArrayProperty::value_type value;
-      prop->mQuatfArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mQuatfArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2019,7 +2028,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_quatd_array: {
       Abc::IQuatdArrayProperty::sample_ptr_type sample;
       Abc::IQuatdArrayProperty::value_type value;
-      prop->mQuatdArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mQuatdArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2041,7 +2050,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c3h_array: {
       Abc::IC3hArrayProperty::sample_ptr_type sample;
       Abc::IC3hArrayProperty::value_type value;
-      prop->mC3hArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC3hArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2062,7 +2071,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c3f_array: {
       Abc::IC3fArrayProperty::sample_ptr_type sample;
       Abc::IC3fArrayProperty::value_type value;
-      prop->mC3fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC3fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2083,7 +2092,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c3c_array: {
       Abc::IC3cArrayProperty::sample_ptr_type sample;
       Abc::IC3cArrayProperty::value_type value;
-      prop->mC3cArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC3cArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2107,7 +2116,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c4h_array: {
       Abc::IC4hArrayProperty::sample_ptr_type sample;
       Abc::IC4hArrayProperty::value_type value;
-      prop->mC4hArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC4hArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2129,7 +2138,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c4f_array: {
       Abc::IC4fArrayProperty::sample_ptr_type sample;
       Abc::IC4fArrayProperty::value_type value;
-      prop->mC4fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC4fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2151,7 +2160,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_c4c_array: {
       Abc::IC4cArrayProperty::sample_ptr_type sample;
       Abc::IC4cArrayProperty::value_type value;
-      prop->mC4cArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mC4cArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2177,7 +2186,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_n2f_array: {
       Abc::IN2fArrayProperty::sample_ptr_type sample;
       Abc::IN2fArrayProperty::value_type value;
-      prop->mN2fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mN2fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2197,7 +2206,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_n2d_array: {
       Abc::IN2dArrayProperty::sample_ptr_type sample;
       Abc::IN2dArrayProperty::value_type value;
-      prop->mN2dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mN2dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2217,7 +2226,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_n3f_array: {
       Abc::IN3fArrayProperty::sample_ptr_type sample;
       Abc::IN3fArrayProperty::value_type value;
-      prop->mN3fArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mN3fArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2238,7 +2247,7 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
     case propertyTP_n3d_array: {
       Abc::IN3dArrayProperty::sample_ptr_type sample;
       Abc::IN3dArrayProperty::value_type value;
-      prop->mN3dArrayProperty->get(sample, sampleIndex);
+      _GET_ARRAY_SAMPLE_(mN3dArrayProperty);
       if (start >= sample->size()) {
         tuple = PyTuple_New(0);
       }
@@ -2263,6 +2272,126 @@ static PyObject *iProperty_getValues(PyObject *self, PyObject *args)
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
+static PyObject *iProperty_getBuffer(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  iProperty *prop = (iProperty *)self;
+  if (!prop->mIsArray || prop->mPropType == propertyTP_unknown) {
+    PyErr_SetString(getError(),
+                    "Only array properties can be accessed as a buffer!");
+    return NULL;
+  }
+
+  unsigned long long sampleIndex = 0;
+  PyArg_ParseTuple(args, "|K", &sampleIndex);
+
+  size_t numSamples = iProperty_getNbStoredSamples_func(self);
+  if (sampleIndex >= numSamples) {
+    std::string msg;
+    msg.append("SampleIndex for Property '");
+    msg.append(iProperty_getName_func(self));
+    msg.append("' is out of bounds!");
+    PyErr_SetString(getError(), msg.c_str());
+    return NULL;
+  }
+
+  // the buffer shares the sample, nothing is converted nor copied
+  AbcA::ArraySamplePtr sample;
+  {
+    allowThreads threads(prop->mAllowThreads);
+    prop->mBaseArrayProperty->get(
+        sample, Abc::ISampleSelector((AbcA::index_t)sampleIndex));
+  }
+  return ArraySample_asBuffer(ArraySample_new(sample));
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+static PyObject *iProperty_getValuesRange(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  iProperty *prop = (iProperty *)self;
+  if (prop->mPropType == propertyTP_unknown) {
+    PyErr_SetString(getError(), "Unknown property type!");
+    return NULL;
+  }
+
+  const size_t numSamples = iProperty_getNbStoredSamples_func(self);
+  unsigned long long first = 0;
+  unsigned long long last = numSamples;
+  PyArg_ParseTuple(args, "|KK", &first, &last);
+  if (last > numSamples) {
+    last = numSamples;
+  }
+  if (first > last) {
+    std::string msg;
+    msg.append("Invalid sample range for Property '");
+    msg.append(iProperty_getName_func(self));
+    msg.append("'!");
+    PyErr_SetString(getError(), msg.c_str());
+    return NULL;
+  }
+
+  const AbcA::DataType dataType =
+      prop->mIsArray ? prop->mBaseArrayProperty->getDataType()
+                     : prop->mBaseScalarProperty->getDataType();
+  if (ArraySample_getFormat(dataType.getPod()) == NULL) {
+    PyErr_SetString(getError(),
+                    "String properties can't be accessed as a buffer!");
+    return NULL;
+  }
+
+  // all the samples are packed in one block, offsets[i] is the first element
+  // of sample first + i
+  const size_t nbSamples = (size_t)(last - first);
+  const size_t elementSize = dataType.getNumBytes();
+  AbcU::shared_ptr<std::vector<char> > values(new std::vector<char>());
+  AbcU::shared_ptr<std::vector<AbcU::uint64_t> > offsets(
+      new std::vector<AbcU::uint64_t>(nbSamples + 1, 0));
+  {
+    allowThreads threads(prop->mAllowThreads);
+    if (prop->mIsArray) {
+      std::vector<AbcA::ArraySamplePtr> samples(nbSamples);
+      for (size_t i = 0; i < nbSamples; ++i) {
+        prop->mBaseArrayProperty->get(
+            samples[i], Abc::ISampleSelector((AbcA::index_t)(first + i)));
+        (*offsets)[i + 1] = (*offsets)[i] + samples[i]->size();
+      }
+      values->resize((size_t)offsets->back() * elementSize);
+      for (size_t i = 0; i < nbSamples; ++i) {
+        if (samples[i]->size()) {
+          memcpy(&(*values)[(size_t)(*offsets)[i] * elementSize],
+                 samples[i]->getData(), samples[i]->size() * elementSize);
+        }
+      }
+    }
+    else {
+      values->resize(nbSamples * elementSize);
+      for (size_t i = 0; i < nbSamples; ++i) {
+        prop->mBaseScalarProperty->get(
+            &(*values)[i * elementSize],
+            Abc::ISampleSelector((AbcA::index_t)(first + i)));
+        (*offsets)[i + 1] = i + 1;
+      }
+    }
+  }
+
+  PyObject *valuesBuffer = ArraySample_asBuffer(ArraySample_new(
+      values, values->empty() ? NULL : &(*values)[0], dataType,
+      (size_t)offsets->back()));
+  if (valuesBuffer == NULL) {
+    return NULL;
+  }
+  PyObject *offsetsBuffer = ArraySample_asBuffer(
+      ArraySample_new(offsets, &(*offsets)[0],
+                      AbcA::DataType(AbcA::kUint64POD, 1), offsets->size()));
+  if (offsetsBuffer == NULL) {
+    Py_DECREF(valuesBuffer);
+    return NULL;
+  }
+  return Py_BuildValue("(NN)", valuesBuffer, offsetsBuffer);
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
 static PyObject *iProperty_isCompound(PyObject *self, PyObject *args)
 {
   Py_INCREF(Py_False);
@@ -2284,6 +2413,19 @@ static PyMethodDef iProperty_methods[] = {
      "array."},
     {"getValues", (PyCFunction)iProperty_getValues, METH_VARARGS,
      "Returns the values of the property at the (optional) sample index."},
+    {"getBuffer", (PyCFunction)iProperty_getBuffer, METH_VARARGS,
+     "Returns the values of an array property at the (optional) sample index "
+     "as a read-only buffer, without any conversion. The shape is (size, "
+     "extent) and the format the one of the struct module. With Python 2.7 a "
+     "memoryview is returned, older versions return an ArraySample object "
+     "that supports the buffer interface."},
+    {"getValuesRange", (PyCFunction)iProperty_getValuesRange, METH_VARARGS,
+     "Returns the values of the samples [first, last) (by default all of "
+     "them) in one call, as a tuple of two read-only buffers like the one of "
+     "getBuffer. The first one holds the values of all the samples one after "
+     "the other, with a (size, extent) shape. The second one holds the "
+     "nbSamples + 1 offsets (uint64) of the first element of each sample, so "
+     "sample i spans the elements [offsets[i], offsets[i + 1])."},
     {"isCompound", (PyCFunction)iProperty_isCompound, METH_NOARGS,
      "To distinguish between an iProperty and an iCompoundProperty, always "
      "returns false for iProperty."},
@@ -2814,6 +2956,8 @@ PyObject *iProperty_new(Abc::ICompoundProperty &compound, char *in_propName)
   iProperty *prop = PyObject_NEW(iProperty, &iProperty_Type);
   // INFO_MSG(in_propName << " of type " << propHeader->getDataType());
   if (prop != NULL) {
+    prop->mAllowThreads =
+        isIArchiveOgawa(compound.getObject().getArchive().getName());
     if (propHeader->isCompound()) {
       PyObject_FREE(prop);  // Free it because one will be created in
       // iCompoundProperty_new
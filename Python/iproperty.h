@@ -118,7 +118,8 @@ enum propertyTP {
 typedef struct {
   PyObject_HEAD bool mIsArray;
   propertyTP mPropType;
-  int intent;  // NEW
+  int intent;         // NEW
+  bool mAllowThreads;  // Ogawa archive, reads can release the GIL
   union {
     Abc::IScalarProperty *mBaseScalarProperty;
     Abc::IArrayProperty *mBaseArrayProperty;
@@ -118,24 +118,45 @@ static PyObject *oArchive_createTimeSampling(PyObject *self, PyObject *args)
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
-static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
+// schema prefixes, without the version, of the objects that can be created
+struct oArchiveObjectType {
+  const char *prefix;
+  size_t length;
+  oObjectType type;
+};
+
+static const oArchiveObjectType oArchive_objectTypes[] = {
+    {"AbcGeom_Xform_", 14, oObjectType_Xform},
+    {"AbcGeom_Camera_", 15, oObjectType_Camera},
+    {"AbcGeom_PolyMesh_", 17, oObjectType_PolyMesh},
+    {"AbcGeom_SubD_", 13, oObjectType_SubD},
+    {"AbcGeom_Curve_", 14, oObjectType_Curves},
+    {"AbcGeom_Points_", 15, oObjectType_Points},
+    {"AbcGeom_FaceSet_", 16, oObjectType_FaceSet},
+    {"AbcGeom_NuPatch_", 16, oObjectType_NuPatch}};
+
+static bool oArchive_getObjectType(const char *typeStr, oObjectType &type)
 {
-  ALEMBIC_TRY_STATEMENT
-  oArchive *archive = (oArchive *)self;
-  if (archive->mArchive == NULL) {
-    PyErr_SetString(getError(), "Archive already closed!");
-    return NULL;
+  const size_t nbTypes =
+      sizeof(oArchive_objectTypes) / sizeof(oArchive_objectTypes[0]);
+  for (size_t i = 0; i < nbTypes; ++i) {
+    if (strncmp(typeStr, oArchive_objectTypes[i].prefix,
+                oArchive_objectTypes[i].length) == 0) {
+      type = oArchive_objectTypes[i].type;
+      return true;
+    }
   }
+  return false;
+}
 
-  // parse the args
-  char *type = NULL;
-  char *identifier = NULL;
-  int tsIndex = 1;
-  if (!PyArg_ParseTuple(args, "ss|i", &type, &identifier, &tsIndex)) {
-    PyErr_SetString(
-        getError(),
-        "No type, identifier and / or timeSamplingIndex specified!");
-    return NULL;
+static PyObject *oArchive_createObjectInternal(oArchive *archive,
+                                               const char *type,
+                                               std::string identifier,
+                                               int tsIndex)
+{
+  // a relative identifier is below the top object
+  if (identifier.empty() || identifier[0] != '/') {
+    identifier.insert(0, 1, '/');
   }
 
   // check if the timesampling is in range
@@ -144,14 +165,13 @@ static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
     return NULL;
   }
 
-  // split the path
-  std::string identifierStr(identifier);
-  std::vector<std::string> parts;
-  boost::split(parts, identifierStr, boost::is_any_of("/"));
-  if (parts.size() < 2) {
+  // split the path, the parent is everything before the last separator
+  const size_t separator = identifier.rfind('/');
+  if (separator == std::string::npos || separator + 1 == identifier.size()) {
     PyErr_SetString(getError(), "Invalid identifier!");
     return NULL;
   }
+  const std::string name = identifier.substr(separator + 1);
 
   oObject *objectPtr = oArchive_getObjectElement(archive, identifier);
   if (objectPtr) {
@@ -162,15 +182,11 @@ static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
                                    // kind of error
   }
 
-  // recurse to find it
+  // look for the parent in our map
   Abc::OObject parent = archive->mArchive->getTop();
-  if (parts.size() > 2) {
-    // look for the parent in our map
-    std::string parentIdentifier = "";
-    for (size_t i = 1; i < parts.size() - 1; i++) {
-      parentIdentifier += "/" + parts[i];
-    }
-    oObject *parentPtr = oArchive_getObjectElement(archive, parentIdentifier);
+  if (separator > 0) {
+    oObject *parentPtr =
+        oArchive_getObjectElement(archive, identifier.substr(0, separator));
     if (!parentPtr) {
       PyErr_SetString(getError(), "Invalid identifier!");
       return NULL;
@@ -181,76 +197,53 @@ static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
   }
 
   // now validate the type
-  std::string typeStr(type);
   oObjectPtr casted;
-  Abc::OObject obj;
-  if (typeStr.substr(0, 14) == "AbcGeom_Xform_") {
-    casted.mType = oObjectType_Xform;
-    casted.mXform = new AbcG::OXform(parent, parts[parts.size() - 1], tsIndex);
-    obj = Abc::OObject(*casted.mXform, Abc::kWrapExisting);
+  if (!oArchive_getObjectType(type, casted.mType)) {
+    if (parent.getMetaData().get("schema").substr(0, 14) != "AbcGeom_Xform_") {
+      PyErr_SetString(
+          getError(),
+          "This type of object has to be put below a xform object!");
+    }
+    else {
+      PyErr_SetString(getError(), "Object type invalid!");
+    }
+    return NULL;
   }
-  else {
-    // if we are not a transform, ensure that we are nested below a xform!
-    // INFO_MSG("parent.getMetaData().get(\"schema\") = " <<
-    // parent.getMetaData().get("schema"));
-    // INFO_MSG("type string = " << typeStr);
-
-    if (typeStr.substr(0, 15) == "AbcGeom_Camera_") {
-      casted.mType = oObjectType_Camera;
-      casted.mCamera =
-          new AbcG::OCamera(parent, parts[parts.size() - 1], tsIndex);
+
+  Abc::OObject obj;
+  switch (casted.mType) {
+    case oObjectType_Xform:
+      casted.mXform = new AbcG::OXform(parent, name, tsIndex);
+      obj = Abc::OObject(*casted.mXform, Abc::kWrapExisting);
+      break;
+    case oObjectType_Camera:
+      casted.mCamera = new AbcG::OCamera(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mCamera, Abc::kWrapExisting);
-    }
-    else if (typeStr.substr(0, 17) == "AbcGeom_PolyMesh_") {
-      casted.mType = oObjectType_PolyMesh;
-      casted.mPolyMesh =
-          new AbcG::OPolyMesh(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_PolyMesh:
+      casted.mPolyMesh = new AbcG::OPolyMesh(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mPolyMesh, Abc::kWrapExisting);
-    }
-    else if (typeStr.substr(0, 13) == "AbcGeom_SubD_") {
-      casted.mType = oObjectType_SubD;
-      casted.mSubD = new AbcG::OSubD(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_SubD:
+      casted.mSubD = new AbcG::OSubD(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mSubD, Abc::kWrapExisting);
-    }
-    else if (typeStr.substr(0, 14) == "AbcGeom_Curve_") {
-      casted.mType = oObjectType_Curves;
-      casted.mCurves =
-          new AbcG::OCurves(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_Curves:
+      casted.mCurves = new AbcG::OCurves(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mCurves, Abc::kWrapExisting);
-    }
-    else if (typeStr.substr(0, 15) == "AbcGeom_Points_") {
-      casted.mType = oObjectType_Points;
-      casted.mPoints =
-          new AbcG::OPoints(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_Points:
+      casted.mPoints = new AbcG::OPoints(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mPoints, Abc::kWrapExisting);
-    }
-
-    // **** NEW
-    else if (typeStr.substr(0, 16) == "AbcGeom_FaceSet_") {
-      casted.mType = oObjectType_FaceSet;
-      casted.mFaceSet =
-          new AbcG::OFaceSet(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_FaceSet:
+      casted.mFaceSet = new AbcG::OFaceSet(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mFaceSet, Abc::kWrapExisting);
-    }
-    else if (typeStr.substr(0, 16) == "AbcGeom_NuPatch_") {
-      casted.mType = oObjectType_NuPatch;
-      casted.mNuPatch =
-          new AbcG::ONuPatch(parent, parts[parts.size() - 1], tsIndex);
+      break;
+    case oObjectType_NuPatch:
+      casted.mNuPatch = new AbcG::ONuPatch(parent, name, tsIndex);
       obj = Abc::OObject(*casted.mNuPatch, Abc::kWrapExisting);
-    }
-
-    // moved at the end!! let see if it works
-    else if (parent.getMetaData().get("schema").substr(0, 14) !=
-             "AbcGeom_Xform_") {
-      PyErr_SetString(
-          getError(),
-          "This type of object has to be put below a xform object!");
-      return NULL;
-    }
-    else {
-      PyErr_SetString(getError(), "Object type invalid!");
-      return NULL;
-    }
+      break;
   }
 
   if (!obj.valid()) {
@@ -260,15 +253,94 @@ static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
 
 // keep a copy of each object until we delete the archive
 #ifdef PYTHON_DEBUG
-  printf("creating new object: '%s'\n", identifier);
+  printf("creating new object: '%s'\n", identifier.c_str());
 #endif
   PyObject *newObj = oObject_new(obj, casted, archive, tsIndex);
 #ifdef PYTHON_DEBUG
-  printf("inserting object into map: '%s'\n", identifier);
+  printf("inserting object into map: '%s'\n", identifier.c_str());
 #endif
   // manually increase the reference count
   oArchive_registerObjectElement(archive, identifier, (oObject *)newObj);
   return newObj;
+}
+
+static PyObject *oArchive_createObject(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  oArchive *archive = (oArchive *)self;
+  if (archive->mArchive == NULL) {
+    PyErr_SetString(getError(), "Archive already closed!");
+    return NULL;
+  }
+
+  // parse the args
+  char *type = NULL;
+  char *identifier = NULL;
+  int tsIndex = 1;
+  if (!PyArg_ParseTuple(args, "ss|i", &type, &identifier, &tsIndex)) {
+    PyErr_SetString(
+        getError(),
+        "No type, identifier and / or timeSamplingIndex specified!");
+    return NULL;
+  }
+
+  return oArchive_createObjectInternal(archive, type, identifier, tsIndex);
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
+static PyObject *oArchive_createObjects(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  oArchive *archive = (oArchive *)self;
+  if (archive->mArchive == NULL) {
+    PyErr_SetString(getError(), "Archive already closed!");
+    return NULL;
+  }
+
+  PyObject *objects = NULL;
+  if (!PyArg_ParseTuple(args, "O", &objects)) {
+    PyErr_SetString(getError(), "No list of objects specified!");
+    return NULL;
+  }
+  PyObject *seq = PySequence_Fast(objects, "");
+  if (seq == NULL) {
+    PyErr_SetString(getError(), "objects argument is not a list!");
+    return NULL;
+  }
+
+  // parents have to come before their children
+  const Py_ssize_t nbObjects = PySequence_Fast_GET_SIZE(seq);
+  PyObject *list = PyList_New(nbObjects);
+  if (list == NULL) {
+    Py_DECREF(seq);
+    return NULL;
+  }
+  for (Py_ssize_t i = 0; i < nbObjects; ++i) {
+    char *type = NULL;
+    char *identifier = NULL;
+    int tsIndex = 1;
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    if (!PyTuple_Check(item) ||
+        !PyArg_ParseTuple(item, "ss|i", &type, &identifier, &tsIndex)) {
+      PyErr_SetString(getError(),
+                      "item should be a tuple (type, identifier[, "
+                      "timeSamplingIndex])!");
+      Py_DECREF(list);
+      Py_DECREF(seq);
+      return NULL;
+    }
+
+    PyObject *object =
+        oArchive_createObjectInternal(archive, type, identifier, tsIndex);
+    if (object == NULL) {
+      Py_DECREF(list);
+      Py_DECREF(seq);
+      return NULL;
+    }
+    PyList_SET_ITEM(list, i, object);
+  }
+  Py_DECREF(seq);
+  return list;
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
@@ -284,6 +356,10 @@ static PyMethodDef oArchive_methods[] = {
      "optional timeSamplingIndex. Returns the created oObject or, if it "
      "already exists, a reference to this oObject. Valid object types can be "
      "found in AppendixA of the documentation."},
+    {"createObjects", (PyCFunction)oArchive_createObjects, METH_VARARGS,
+     "Takes in a list of (type, identifier[, timeSamplingIndex]) tuples and "
+     "creates all the objects at once, parents before their children. Returns "
+     "the list of oObjects, in the same order."},
     {NULL, NULL}};
 
 static PyObject *oArchive_getAttr(PyObject *self, char *attrName)
@@ -338,7 +414,13 @@ static void oArchive_delete(PyObject *self)
     archive->mElements->clear();
     delete (archive->mElements);
     archive->mElements = NULL;
-    delete (archive->mArchive);
+    delete (archive->mElementIndices);
+    archive->mElementIndices = NULL;
+    {
+      // Ogawa writes its index when the archive is closed
+      allowThreads threads(archive->mUseOgawa);
+      delete (archive->mArchive);
+    }
     archive->mArchive = NULL;
 #ifdef PYTHON_DEBUG
     printf("closed archive.\n");
@@ -420,10 +502,15 @@ PyObject *oArchive_new(PyObject *self, PyObject *args)
   oArchive *object = PyObject_NEW(oArchive, &oArchive_Type);
   if (object != NULL) {
     object->mArchive = new Abc::OArchive();
-    createArchive(object, fileName, useOgawa);
-    AbcG::CreateOArchiveBounds(*object->mArchive, 0);
+    object->mUseOgawa = useOgawa;
+    {
+      allowThreads threads(useOgawa);
+      createArchive(object, fileName, useOgawa);
+      AbcG::CreateOArchiveBounds(*object->mArchive, 0);
+    }
 
     object->mElements = new oArchiveElementVec();
+    object->mElementIndices = new oArchiveElementMap();
     setOArchiveOpened(fileName);
     gNbOArchives++;
   }
@@ -441,6 +528,14 @@ static void init_oArchiveElement(oArchiveElement &element,
   element.xform = NULL;
 }
 
+static void oArchive_addElement(oArchive *archive,
+                                const oArchiveElement &element)
+{
+  archive->mElementIndices->insert(
+      std::make_pair(element.identifier, archive->mElements->size()));
+  archive->mElements->push_back(element);
+}
+
 void oArchive_registerObjectElement(oArchive *archive, std::string identifier,
                                     oObject *object)
 {
@@ -451,7 +546,7 @@ void oArchive_registerObjectElement(oArchive *archive, std::string identifier,
   init_oArchiveElement(element, identifier);
 
   element.object = object;
-  archive->mElements->push_back(element);
+  oArchive_addElement(archive, element);
   Py_INCREF(object);
 }
 
@@ -462,7 +557,7 @@ void oArchive_registerPropElement(oArchive *archive, std::string identifier,
   init_oArchiveElement(element, identifier);
 
   element.prop = prop;
-  archive->mElements->push_back(element);
+  oArchive_addElement(archive, element);
   Py_INCREF(prop);
 }
 
@@ -473,7 +568,7 @@ void oArchive_registerCompPropElement(oArchive *archive, std::string identifier,
   init_oArchiveElement(element, identifier);
 
   element.comp_prop = comp_prop;
-  archive->mElements->push_back(element);
+  oArchive_addElement(archive, element);
   Py_INCREF(comp_prop);
 }
 
@@ -487,21 +582,19 @@ void oArchive_registerXformElement(oArchive *archive, std::string identifier,
   init_oArchiveElement(element, identifier);
 
   element.xform = xform;
-  archive->mElements->push_back(element);
+  oArchive_addElement(archive, element);
   Py_INCREF(xform);
 }
 
 static oArchiveElement *oArchive_getArchiveElement(oArchive *archive,
-                                                   std::string identifier)
+                                                   const std::string &identifier)
 {
-  oArchiveElementVec &elements = (*archive->mElements);
-  oArchiveElementVec::iterator end = elements.end();
-  for (oArchiveElementVec::iterator beg = elements.begin(); beg != end; ++beg) {
-    if (beg->identifier == identifier) {
-      return &(*beg);
-    }
+  oArchiveElementMap::const_iterator it =
+      archive->mElementIndices->find(identifier);
+  if (it == archive->mElementIndices->end()) {
+    return NULL;
   }
-  return NULL;
+  return &(*archive->mElements)[it->second];
 }
 
 oObject *oArchive_getObjectElement(oArchive *archive, std::string identifier)
@@ -530,6 +623,11 @@ oXformProperty *oArchive_getXformElement(oArchive *archive,
   return element ? element->xform : NULL;
 }
 
+bool PyObject_oArchive_Check(PyObject *obj)
+{
+  return obj->ob_type == &oArchive_Type;
+}
+
 bool register_object_oArchive(PyObject *module)
 {
   return register_object(module, oArchive_Type, "oArchive");
@@ -1,6 +1,7 @@
 #ifndef _PYTHON_ALEMBIC_OARCHIVE_H_
 #define _PYTHON_ALEMBIC_OARCHIVE_H_
 
+#include <boost/unordered_map.hpp>
 #include "ocompoundproperty.h"
 #include "oobject.h"
 #include "oproperty.h"
@@ -16,9 +17,14 @@ struct oArchiveElement {
 
 typedef std::vector<oArchiveElement> oArchiveElementVec;
 
+// identifier -> index of the first element registered with it
+typedef boost::unordered_map<std::string, size_t> oArchiveElementMap;
+
 typedef struct {
   PyObject_HEAD Abc::OArchive *mArchive;
   oArchiveElementVec *mElements;
+  oArchiveElementMap *mElementIndices;
+  bool mUseOgawa;  // Ogawa archive, writes can release the GIL
 } oArchive;
 
 void oArchive_registerObjectElement(oArchive *archive, std::string identifier,
@@ -41,6 +47,7 @@ PyObject *oArchive_new(PyObject *self, PyObject *args);
 size_t getNbOArchives();
 bool isOArchiveOpened(std::string filename);
 
+bool PyObject_oArchive_Check(PyObject *obj);
 bool register_object_oArchive(PyObject *module);
 
 #endif
@@ -0,0 +1,499 @@
+#include "stdafx.h"
+
+#include "objconvert.h"
+#include <boost/bind.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/thread.hpp>
+#include <limits>
+#include "CommonUtilities.h"
+#include "extension.h"
+#include "oarchive.h"
+
+namespace {
+
+// a corner without texture coordinate or normal
+const Abc::int32_t gMissingIndex = std::numeric_limits<Abc::int32_t>::min();
+
+// below that size, spawning threads costs more than it saves
+const size_t gParallelParseThreshold = 1 << 22;
+
+// what one chunk of the file holds. Indices are 0 based, the relative ones
+// (negative in the file) are relative to the start of the chunk until the
+// chunks are merged, their positions are kept aside.
+struct objData {
+  std::vector<Abc::V3f> positions;
+  std::vector<Abc::V2f> uvs;
+  std::vector<Abc::N3f> normals;
+  std::vector<Abc::int32_t> faceCounts;
+  std::vector<Abc::int32_t> vertexIndices;
+  std::vector<Abc::int32_t> uvIndices;
+  std::vector<Abc::int32_t> normalIndices;
+
+  std::vector<size_t> relativeVertices;
+  std::vector<size_t> relativeUvs;
+  std::vector<size_t> relativeNormals;
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline const char *skipBlanks(const char *p, const char *end)
+{
+  while (p < end && isBlank(*p)) {
+    ++p;
+  }
+  return p;
+}
+
+// the line starts with keyword followed by a blank
+inline bool isKeyword(const char *p, const char *end, const char *keyword)
+{
+  for (; *keyword; ++keyword, ++p) {
+    if (p >= end || *p != *keyword) {
+      return false;
+    }
+  }
+  return p < end && isBlank(*p);
+}
+
+double powerOf10(int exponent)
+{
+  static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                  1e12, 1e13, 1e14, 1e15, 1e16};
+  return exponent <= 16 ? powers[exponent] : pow(10.0, exponent);
+}
+
+// the mapped file isn't null terminated, so strtod can't be used
+bool parseFloat(const char *&p, const char *end, float &value)
+{
+  p = skipBlanks(p, end);
+  const char *start = p;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+
+  double mantissa = 0.0;
+  int exponent = 0;
+  bool hasDigits = false;
+  for (; p < end && isDigit(*p); ++p, hasDigits = true) {
+    mantissa = mantissa * 10.0 + (*p - '0');
+  }
+  if (p < end && *p == '.') {
+    for (++p; p < end && isDigit(*p); ++p, hasDigits = true) {
+      mantissa = mantissa * 10.0 + (*p - '0');
+      --exponent;
+    }
+  }
+  if (!hasDigits) {
+    p = start;
+    return false;
+  }
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    const char *e = p + 1;
+    bool negativeExponent = false;
+    if (e < end && (*e == '-' || *e == '+')) {
+      negativeExponent = *e == '-';
+      ++e;
+    }
+    if (e < end && isDigit(*e)) {
+      int value = 0;
+      for (; e < end && isDigit(*e); ++e) {
+        value = value * 10 + (*e - '0');
+      }
+      exponent += negativeExponent ? -value : value;
+      p = e;
+    }
+  }
+
+  const double result = exponent >= 0 ? mantissa * powerOf10(exponent)
+                                      : mantissa / powerOf10(-exponent);
+  value = (float)(negative ? -result : result);
+  return true;
+}
+
+bool parseInt(const char *&p, const char *end, int &value)
+{
+  const char *start = p;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) {
+    negative = *p == '-';
+    ++p;
+  }
+  if (p >= end || !isDigit(*p)) {
+    p = start;
+    return false;
+  }
+  value = 0;
+  for (; p < end && isDigit(*p); ++p) {
+    value = value * 10 + (*p - '0');
+  }
+  if (negative) {
+    value = -value;
+  }
+  return true;
+}
+
+void addIndex(int index, bool found, size_t nbValues,
+              std::vector<Abc::int32_t> &indices,
+              std::vector<size_t> &relative)
+{
+  if (!found || index == 0) {
+    indices.push_back(gMissingIndex);
+  }
+  else if (index > 0) {
+    indices.push_back(index - 1);
+  }
+  else {
+    relative.push_back(indices.size());
+    indices.push_back((Abc::int32_t)nbValues + index);
+  }
+}
+
+void parseFace(const char *p, const char *end, objData &data)
+{
+  Abc::int32_t count = 0;
+  for (;;) {
+    p = skipBlanks(p, end);
+    int v = 0, t = 0, n = 0;
+    if (!parseInt(p, end, v)) {
+      break;
+    }
+    bool hasT = false, hasN = false;
+    if (p < end && *p == '/') {
+      ++p;
+      hasT = parseInt(p, end, t);
+      if (p < end && *p == '/') {
+        ++p;
+        hasN = parseInt(p, end, n);
+      }
+    }
+
+    addIndex(v, true, data.positions.size(), data.vertexIndices,
+             data.relativeVertices);
+    addIndex(t, hasT, data.uvs.size(), data.uvIndices, data.relativeUvs);
+    addIndex(n, hasN, data.normals.size(), data.normalIndices,
+             data.relativeNormals);
+    ++count;
+  }
+  if (count) {
+    data.faceCounts.push_back(count);
+  }
+}
+
+// only positions, texture coordinates, normals and faces are read
+void parseChunk(const char *begin, const char *end, objData &data)
+{
+  while (begin < end) {
+    const char *eol = (const char *)memchr(begin, '\n', end - begin);
+    if (eol == NULL) {
+      eol = end;
+    }
+
+    const char *p = skipBlanks(begin, eol);
+    float x, y, z;
+    if (isKeyword(p, eol, "v")) {
+      p += 1;
+      if (parseFloat(p, eol, x) && parseFloat(p, eol, y) &&
+          parseFloat(p, eol, z)) {
+        data.positions.push_back(Abc::V3f(x, y, z));
+      }
+    }
+    else if (isKeyword(p, eol, "vt")) {
+      p += 2;
+      if (parseFloat(p, eol, x) && parseFloat(p, eol, y)) {
+        data.uvs.push_back(Abc::V2f(x, y));
+      }
+    }
+    else if (isKeyword(p, eol, "vn")) {
+      p += 2;
+      if (parseFloat(p, eol, x) && parseFloat(p, eol, y) &&
+          parseFloat(p, eol, z)) {
+        data.normals.push_back(Abc::N3f(x, y, z));
+      }
+    }
+    else if (isKeyword(p, eol, "f")) {
+      parseFace(p + 1, eol, data);
+    }
+    begin = eol + 1;
+  }
+}
+
+template <typename T>
+void appendValues(std::vector<T> &dest, const std::vector<T> &src)
+{
+  dest.insert(dest.end(), src.begin(), src.end());
+}
+
+void appendIndices(std::vector<Abc::int32_t> &dest,
+                   std::vector<Abc::int32_t> &src,
+                   const std::vector<size_t> &relative, size_t base)
+{
+  for (size_t i = 0; i < relative.size(); ++i) {
+    src[relative[i]] += (Abc::int32_t)base;
+  }
+  appendValues(dest, src);
+}
+
+// the chunks are parsed in parallel, then merged in order
+void parseOBJ(const char *begin, size_t size, objData &mesh)
+{
+  size_t nbChunks = 1;
+  if (size >= gParallelParseThreshold) {
+    nbChunks = std::max(1u, boost::thread::hardware_concurrency());
+  }
+
+  // chunks are cut after a new line
+  std::vector<const char *> bounds(nbChunks + 1, begin + size);
+  bounds[0] = begin;
+  for (size_t k = 1; k < nbChunks; ++k) {
+    const char *p = std::max(bounds[k - 1], begin + size * k / nbChunks);
+    const char *eol = (const char *)memchr(p, '\n', begin + size - p);
+    bounds[k] = eol ? eol + 1 : begin + size;
+  }
+
+  std::vector<objData> chunks(nbChunks);
+  if (nbChunks == 1) {
+    parseChunk(bounds[0], bounds[1], chunks[0]);
+  }
+  else {
+    boost::thread_group threads;
+    for (size_t k = 0; k < nbChunks; ++k) {
+      threads.create_thread(boost::bind(&parseChunk, bounds[k], bounds[k + 1],
+                                        boost::ref(chunks[k])));
+    }
+    threads.join_all();
+  }
+
+  for (size_t k = 0; k < nbChunks; ++k) {
+    objData &chunk = chunks[k];
+    appendIndices(mesh.vertexIndices, chunk.vertexIndices,
+                  chunk.relativeVertices, mesh.positions.size());
+    appendIndices(mesh.uvIndices, chunk.uvIndices, chunk.relativeUvs,
+                  mesh.uvs.size());
+    appendIndices(mesh.normalIndices, chunk.normalIndices,
+                  chunk.relativeNormals, mesh.normals.size());
+    appendValues(mesh.positions, chunk.positions);
+    appendValues(mesh.uvs, chunk.uvs);
+    appendValues(mesh.normals, chunk.normals);
+    appendValues(mesh.faceCounts, chunk.faceCounts);
+
+    // release the chunk as soon as it's merged
+    chunk = objData();
+  }
+}
+
+// expands the values of a face-varying attribute in the Alembic winding,
+// false if a corner has no value
+template <typename T>
+bool expandValues(const std::vector<Abc::int32_t> &corners,
+                  const std::vector<T> &values, std::vector<T> &expanded)
+{
+  expanded.resize(corners.size());
+  for (size_t i = 0; i < corners.size(); ++i) {
+    if (corners[i] < 0 || corners[i] >= (Abc::int32_t)values.size()) {
+      return false;
+    }
+    expanded[i] = values[corners[i]];
+  }
+  return true;
+}
+
+// reverses the winding of every face, OBJ faces are counter-clockwise and
+// Alembic ones clockwise
+void reverseWinding(const std::vector<Abc::int32_t> &faceCounts,
+                    std::vector<Abc::int32_t> &indices)
+{
+  size_t offset = 0;
+  for (size_t f = 0; f < faceCounts.size(); ++f) {
+    std::reverse(indices.begin() + offset,
+                 indices.begin() + offset + faceCounts[f]);
+    offset += faceCounts[f];
+  }
+}
+
+void writeSample(const objData &mesh, const std::string &fileName,
+                 AbcG::OPolyMeshSchema &schema)
+{
+  std::vector<Abc::int32_t> faceIndices = mesh.vertexIndices;
+  for (size_t i = 0; i < faceIndices.size(); ++i) {
+    if (faceIndices[i] < 0 ||
+        faceIndices[i] >= (Abc::int32_t)mesh.positions.size()) {
+      ABCA_THROW("Invalid vertex index in " << fileName << "!");
+    }
+  }
+  reverseWinding(mesh.faceCounts, faceIndices);
+
+  AbcG::OPolyMeshSchema::Sample sample(Abc::P3fArraySample(mesh.positions),
+                                       Abc::Int32ArraySample(faceIndices),
+                                       Abc::Int32ArraySample(mesh.faceCounts));
+
+  // UVs and normals are welded on <vertex, value> like the plugins do
+  std::vector<Abc::V2f> uvValues;
+  std::vector<Abc::uint32_t> uvIndices;
+  std::vector<Abc::int32_t> uvCorners = mesh.uvIndices;
+  std::vector<Abc::V2f> expandedUvs;
+  reverseWinding(mesh.faceCounts, uvCorners);
+  if (!mesh.uvs.empty() && expandValues(uvCorners, mesh.uvs, expandedUvs)) {
+    createIndexedArray<Abc::V2f, SortableV2f>(faceIndices, expandedUvs,
+                                              uvValues, uvIndices);
+    sample.setUVs(AbcG::OV2fGeomParam::Sample(
+        Abc::V2fArraySample(uvValues), Abc::UInt32ArraySample(uvIndices),
+        AbcG::kFacevaryingScope));
+  }
+
+  std::vector<Abc::N3f> normalValues;
+  std::vector<Abc::uint32_t> normalIndices;
+  std::vector<Abc::int32_t> normalCorners = mesh.normalIndices;
+  std::vector<Abc::N3f> expandedNormals;
+  reverseWinding(mesh.faceCounts, normalCorners);
+  if (!mesh.normals.empty() &&
+      expandValues(normalCorners, mesh.normals, expandedNormals)) {
+    createIndexedArray<Abc::N3f, SortableV3f>(faceIndices, expandedNormals,
+                                              normalValues, normalIndices);
+    sample.setNormals(AbcG::ON3fGeomParam::Sample(
+        Abc::N3fArraySample(normalValues),
+        Abc::UInt32ArraySample(normalIndices), AbcG::kFacevaryingScope));
+  }
+
+  schema.set(sample);
+}
+
+// a string or a sequence of strings
+bool getFileNames(PyObject *obj, std::vector<std::string> &fileNames)
+{
+  if (PyString_Check(obj)) {
+    fileNames.push_back(PyString_AsString(obj));
+    return true;
+  }
+
+  PyObject *seq = PySequence_Fast(obj, "");
+  if (seq == NULL) {
+    return false;
+  }
+  const Py_ssize_t nbItems = PySequence_Fast_GET_SIZE(seq);
+  for (Py_ssize_t i = 0; i < nbItems; ++i) {
+    PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+    if (!PyString_Check(item)) {
+      Py_DECREF(seq);
+      return false;
+    }
+    fileNames.push_back(PyString_AsString(item));
+  }
+  Py_DECREF(seq);
+  return !fileNames.empty();
+}
+
+}  // namespace
+
+PyObject *convertOBJ(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  ALEMBIC_TRY_STATEMENT
+  static char *kwlist[] = {(char *)"objFiles", (char *)"oArchive",
+                           (char *)"identifier", (char *)"fps", NULL};
+
+  PyObject *pyFiles = NULL, *pyOutput = NULL;
+  char *identifier = (char *)"/pFromObj";
+  double fps = 24.0;
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|sd", kwlist, &pyFiles,
+                                   &pyOutput, &identifier, &fps)) {
+    PyErr_SetString(getError(), "No OBJ files and oArchive specified!");
+    return NULL;
+  }
+
+  std::vector<std::string> fileNames;
+  if (!getFileNames(pyFiles, fileNames)) {
+    PyErr_SetString(getError(),
+                    "objFiles should be a file name or a list of file names!");
+    return NULL;
+  }
+  if (!PyObject_oArchive_Check(pyOutput)) {
+    PyErr_SetString(getError(), "oArchive argument is not an oArchive!");
+    return NULL;
+  }
+  oArchive *archive = (oArchive *)pyOutput;
+  if (archive->mArchive == NULL) {
+    PyErr_SetString(getError(), "Archive already closed!");
+    return NULL;
+  }
+  if (fps <= 0.0) {
+    PyErr_SetString(getError(), "fps should be positive!");
+    return NULL;
+  }
+
+  // the mesh can be created below an object created from Python
+  const std::string identifierStr(identifier);
+  const size_t separator = identifierStr.rfind('/');
+  if (separator == std::string::npos ||
+      separator + 1 == identifierStr.size()) {
+    PyErr_SetString(getError(), "Invalid identifier!");
+    return NULL;
+  }
+  if (oArchive_getObjectElement(archive, identifierStr)) {
+    PyErr_SetString(getError(), "An object with this identifier exists!");
+    return NULL;
+  }
+  Abc::OObject parent = archive->mArchive->getTop();
+  if (separator > 0) {
+    oObject *parentPtr =
+        oArchive_getObjectElement(archive, identifierStr.substr(0, separator));
+    if (!parentPtr || !parentPtr->mObject) {
+      PyErr_SetString(getError(), "Invalid identifier!");
+      return NULL;
+    }
+    parent = *parentPtr->mObject;
+  }
+
+  // a sequence is one frame per file
+  uint32_t tsIndex = 0;
+  if (fileNames.size() > 1) {
+    tsIndex = archive->mArchive->addTimeSampling(
+        AbcA::TimeSampling(1.0 / fps, 0.0));
+  }
+
+  // the mesh is registered in the archive as createObject does, so that
+  // getObject returns it
+  oObjectPtr casted;
+  casted.mType = oObjectType_PolyMesh;
+  casted.mPolyMesh =
+      new AbcG::OPolyMesh(parent, identifierStr.substr(separator + 1), tsIndex);
+  PyObject *newObj =
+      oObject_new(Abc::OObject(*casted.mPolyMesh, Abc::kWrapExisting), casted,
+                  archive, (int)tsIndex);
+  if (newObj == NULL) {
+    delete casted.mPolyMesh;
+    return NULL;
+  }
+  oArchive_registerObjectElement(archive, identifierStr, (oObject *)newObj);
+  Py_DECREF(newObj);
+
+  try {
+    AbcG::OPolyMeshSchema &schema = casted.mPolyMesh->getSchema();
+
+    // only one frame is in memory at a time
+    for (size_t i = 0; i < fileNames.size(); ++i) {
+      objData data;
+      {
+        allowThreads threads(true);
+        namespace bip = boost::interprocess;
+        bip::file_mapping file(fileNames[i].c_str(), bip::read_only);
+        bip::mapped_region region(file, bip::read_only);
+        parseOBJ((const char *)region.get_address(), region.get_size(), data);
+      }
+      {
+        allowThreads threads(archive->mUseOgawa);
+        writeSample(data, fileNames[i], schema);
+      }
+    }
+  }
+  catch (std::exception &e) {
+    PyErr_SetString(getError(), e.what());
+    return NULL;
+  }
+  return Py_BuildValue("i", (int)fileNames.size());
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
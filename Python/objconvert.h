@@ -0,0 +1,6 @@
+#ifndef _PYTHON_ALEMBIC_OBJCONVERT_H_
+#define _PYTHON_ALEMBIC_OBJCONVERT_H_
+
+PyObject *convertOBJ(PyObject *self, PyObject *args, PyObject *kwds);
+
+#endif
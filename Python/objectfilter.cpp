@@ -0,0 +1,57 @@
+#include "stdafx.h"
+
+#include "objectfilter.h"
+
+bool matchGlob(const std::string &pattern, const std::string &str)
+{
+  // iterative matching, only backtracks to the last '*'
+  size_t p = 0, s = 0;
+  size_t starP = std::string::npos, starS = 0;
+  while (s < str.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == str[s])) {
+      ++p;
+      ++s;
+    }
+    else if (p < pattern.size() && pattern[p] == '*') {
+      starP = p++;
+      starS = s;
+    }
+    else if (starP != std::string::npos) {
+      p = starP + 1;
+      s = ++starS;
+    }
+    else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') {
+    ++p;
+  }
+  return p == pattern.size();
+}
+
+bool matchAnyGlob(const std::vector<std::string> &patterns,
+                  const std::string &str)
+{
+  for (size_t i = 0; i < patterns.size(); ++i) {
+    if (matchGlob(patterns[i], str)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool objectFilter::matches(const AbcA::ObjectHeader &header) const
+{
+  if (!schema.empty() &&
+      !matchGlob(schema, header.getMetaData().get("schema"))) {
+    return false;
+  }
+  if (!glob.empty() && !matchGlob(glob, header.getFullName())) {
+    return false;
+  }
+  if (useRegex && !boost::regex_search(header.getFullName(), regex)) {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,31 @@
+#ifndef _PYTHON_ALEMBIC_OBJECTFILTER_H_
+#define _PYTHON_ALEMBIC_OBJECTFILTER_H_
+
+#include <boost/regex.hpp>
+#include <string>
+#include <vector>
+
+// Shell-like wildcard matching of object identifiers: '*' matches any run of
+// characters (including '/'), '?' matches a single character.
+bool matchGlob(const std::string &pattern, const std::string &str);
+bool matchAnyGlob(const std::vector<std::string> &patterns,
+                  const std::string &str);
+
+// Selection of objects on their header only, so that the objects that don't
+// match never have to be opened. Every filter left empty matches everything.
+struct objectFilter {
+  objectFilter() : useRegex(false), maxDepth(-1) {}
+
+  bool matches(const AbcA::ObjectHeader &header) const;
+
+  // the children of the top object are at depth 1
+  bool descends(int depth) const { return maxDepth < 0 || depth < maxDepth; }
+
+  std::string glob;    // matched against the identifier
+  boost::regex regex;  // searched in the identifier
+  bool useRegex;
+  std::string schema;  // glob matched against the schema, as in getType
+  int maxDepth;        // negative for no limit
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include "oproperty.h"
 #include "AlembicLicensing.h"
+#include "arraysample.h"
 #include "extension.h"
 #include "oarchive.h"
 #include "ocompoundproperty.h"
@@ -115,6 +116,189 @@ static PyObject *oProperty_getName(PyObject *self, PyObject *args)
       prop->mXProperty->set(tupleVec[0]);           \
   }
 
+// HDF5 isn't thread safe, only Ogawa writes can release the GIL
+static bool oProperty_allowThreads(oProperty *prop)
+{
+  return ((oArchive *)prop->mArchive)->mUseOgawa;
+}
+
+// array samples are hashed and written without the interpreter lock
+#define _SET_ARRAY_SAMPLE_(mXArrayProperty)             \
+  {                                                     \
+    allowThreads threads(oProperty_allowThreads(prop)); \
+    prop->mXArrayProperty->set(sample);                 \
+  }
+
+#if PY_VERSION_HEX >= 0x02060000
+// releases the buffer even if Alembic throws while writing the sample
+struct oProperty_bufferView {
+  Py_buffer view;
+  bool acquired;
+
+  oProperty_bufferView() : acquired(false) {}
+  ~oProperty_bufferView()
+  {
+    if (acquired) {
+      PyBuffer_Release(&view);
+    }
+  }
+};
+
+static const AbcA::DataType &oProperty_getDataType(oProperty *prop)
+{
+  return prop->mIsArray ? prop->mBaseArrayProperty->getDataType()
+                        : prop->mBaseScalarProperty->getDataType();
+}
+
+// acquires a contiguous buffer whose items match the POD of the property,
+// nbElements receives the number of elements (items / extent)
+static bool oProperty_getValuesBuffer(oProperty *prop, PyObject *buffer,
+                                      oProperty_bufferView &buf,
+                                      size_t &nbElements)
+{
+  if (PyObject_GetBuffer(buffer, &buf.view,
+                         PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) < 0) {
+    return false;
+  }
+  buf.acquired = true;
+
+  const AbcA::DataType &dataType = oProperty_getDataType(prop);
+  if (!ArraySample_isFormatOf(dataType.getPod(), buf.view.format,
+                              buf.view.itemsize)) {
+    PyErr_SetString(getError(),
+                    "The format of the buffer doesn't match the property type!");
+    return false;
+  }
+
+  const size_t nbItems = (size_t)(buf.view.len / buf.view.itemsize);
+  const size_t extent = (size_t)dataType.getExtent();
+  if (nbItems % extent) {
+    PyErr_SetString(getError(),
+                    "Incorrect number of sample items in the buffer!");
+    return false;
+  }
+  nbElements = nbItems / extent;
+  return true;
+}
+
+// writes a sample straight from the memory of a buffer object (numpy arrays,
+// memoryviews, the ArraySample of iProperty.getBuffer...), without any
+// conversion. The buffer has to be contiguous and its items have to match the
+// POD of the property, the number of items a multiple of its extent.
+static bool oProperty_setValuesFromBuffer(oProperty *prop, PyObject *buffer)
+{
+  oProperty_bufferView buf;
+  size_t nbElements = 0;
+  if (!oProperty_getValuesBuffer(prop, buffer, buf, nbElements)) {
+    return false;
+  }
+  if (!prop->mIsArray && nbElements != 1) {
+    PyErr_SetString(getError(),
+                    "Incorrect number of sample items in the buffer!");
+    return false;
+  }
+
+  allowThreads threads(oProperty_allowThreads(prop));
+  if (prop->mIsArray) {
+    prop->mBaseArrayProperty->set(AbcA::ArraySample(
+        buf.view.buf, oProperty_getDataType(prop),
+        AbcA::Dimensions(nbElements)));
+  }
+  else {
+    prop->mBaseScalarProperty->set(buf.view.buf);
+  }
+  return true;
+}
+
+// reads the sample offsets of setValuesRange: a number of samples of equal
+// size, or the nbSamples + 1 offsets of the first element of each sample (a
+// sequence or a buffer of 32 or 64 bits integers)
+static bool oProperty_getOffsets(PyObject *obj, size_t nbElements,
+                                 std::vector<size_t> &offsets)
+{
+  if (PyInt_Check(obj) || PyLong_Check(obj)) {
+    const Py_ssize_t nbSamples = PyNumber_AsSsize_t(obj, NULL);
+    if (nbSamples <= 0 || nbElements % (size_t)nbSamples) {
+      PyErr_SetString(getError(),
+                      "The buffer can't be split in that number of samples!");
+      return false;
+    }
+    const size_t size = nbElements / (size_t)nbSamples;
+    offsets.resize((size_t)nbSamples + 1);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      offsets[i] = i * size;
+    }
+    return true;
+  }
+
+  if (PyObject_CheckBuffer(obj)) {
+    oProperty_bufferView buf;
+    if (PyObject_GetBuffer(obj, &buf.view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) <
+        0) {
+      return false;
+    }
+    buf.acquired = true;
+    const size_t count = (size_t)(buf.view.len / buf.view.itemsize);
+    offsets.resize(count);
+    if (ArraySample_isFormatOf(AbcA::kUint64POD, buf.view.format,
+                               buf.view.itemsize) ||
+        ArraySample_isFormatOf(AbcA::kInt64POD, buf.view.format,
+                               buf.view.itemsize)) {
+      const AbcU::uint64_t *data = (const AbcU::uint64_t *)buf.view.buf;
+      for (size_t i = 0; i < count; ++i) {
+        offsets[i] = (size_t)data[i];
+      }
+    }
+    else if (ArraySample_isFormatOf(AbcA::kUint32POD, buf.view.format,
+                                    buf.view.itemsize) ||
+             ArraySample_isFormatOf(AbcA::kInt32POD, buf.view.format,
+                                    buf.view.itemsize)) {
+      const AbcU::uint32_t *data = (const AbcU::uint32_t *)buf.view.buf;
+      for (size_t i = 0; i < count; ++i) {
+        offsets[i] = (size_t)data[i];
+      }
+    }
+    else {
+      PyErr_SetString(getError(), "The offsets have to be integers!");
+      return false;
+    }
+  }
+  else {
+    PyObject *seq = PySequence_Fast(obj, "The offsets have to be a sequence!");
+    if (seq == NULL) {
+      return false;
+    }
+    offsets.resize((size_t)PySequence_Fast_GET_SIZE(seq));
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      const Py_ssize_t offset =
+          PyNumber_AsSsize_t(PySequence_Fast_GET_ITEM(seq, i), NULL);
+      if (offset < 0) {
+        Py_DECREF(seq);
+        if (!PyErr_Occurred()) {
+          PyErr_SetString(getError(), "The offsets can't be negative!");
+        }
+        return false;
+      }
+      offsets[i] = (size_t)offset;
+    }
+    Py_DECREF(seq);
+  }
+
+  bool valid = offsets.size() >= 2 && offsets.front() == 0 &&
+               offsets.back() == nbElements;
+  for (size_t i = 1; valid && i < offsets.size(); ++i) {
+    valid = offsets[i - 1] <= offsets[i];
+  }
+  if (!valid) {
+    PyErr_SetString(getError(),
+                    "The offsets have to go from 0 to the number of elements "
+                    "in increasing order!");
+    return false;
+  }
+  return true;
+}
+#endif
+
 static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
 {
   ALEMBIC_TRY_STATEMENT
@@ -158,6 +342,14 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
     PyErr_SetString(getError(), "No sample tuple specified!");
     return NULL;
   }
+#if PY_VERSION_HEX >= 0x02060000
+  if (PyObject_CheckBuffer(tuple) && !PyString_Check(tuple)) {
+    if (!oProperty_setValuesFromBuffer(prop, tuple)) {
+      return NULL;
+    }
+    return Py_BuildValue("l", numSamples);
+  }
+#endif
   if (!PyTuple_Check(tuple) && !PyList_Check(tuple)) {
     PyErr_SetString(getError(), "Sample tuple argument is not a tuple!");
     return NULL;
@@ -516,7 +708,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBoolArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mBoolArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBoolArrayProperty);
       break;
     }
     case propertyTP_uchar_array: {
@@ -529,7 +721,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OUcharArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mUcharArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mUcharArrayProperty);
       break;
     }
     case propertyTP_char_array: {
@@ -542,7 +734,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OCharArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mCharArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mCharArrayProperty);
       break;
     }
     case propertyTP_uint16_array: {
@@ -551,7 +743,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OUInt16ArrayProperty::sample_type(tupleVec);
       }
-      prop->mUInt16ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mUInt16ArrayProperty);
       break;
     }
     case propertyTP_int16_array: {
@@ -560,7 +752,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OInt16ArrayProperty::sample_type(tupleVec);
       }
-      prop->mInt16ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mInt16ArrayProperty);
       break;
     }
     case propertyTP_uint32_array: {
@@ -570,7 +762,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OUInt32ArrayProperty::sample_type(tupleVec);
       }
-      prop->mUInt32ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mUInt32ArrayProperty);
       break;
     }
     case propertyTP_int32_array: {
@@ -580,7 +772,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OInt32ArrayProperty::sample_type(tupleVec);
       }
-      prop->mInt32ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mInt32ArrayProperty);
       break;
     }
     case propertyTP_uint64_array: {
@@ -589,7 +781,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OUInt64ArrayProperty::sample_type(tupleVec);
       }
-      prop->mUInt64ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mUInt64ArrayProperty);
       break;
     }
     case propertyTP_int64_array: {
@@ -598,7 +790,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OInt64ArrayProperty::sample_type(tupleVec);
       }
-      prop->mInt64ArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mInt64ArrayProperty);
       break;
     }
     case propertyTP_half_array: {
@@ -607,7 +799,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OHalfArrayProperty::sample_type(tupleVec);
       }
-      prop->mHalfArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mHalfArrayProperty);
       break;
     }
     case propertyTP_float_array: {
@@ -616,7 +808,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OFloatArrayProperty::sample_type(tupleVec);
       }
-      prop->mFloatArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mFloatArrayProperty);
       break;
     }
     case propertyTP_double_array: {
@@ -625,7 +817,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::ODoubleArrayProperty::sample_type(tupleVec);
       }
-      prop->mDoubleArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mDoubleArrayProperty);
       break;
     }
     case propertyTP_string_array: {
@@ -634,7 +826,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (tupleVec.size() > 0) {
         sample = Abc::OStringArrayProperty::sample_type(tupleVec);
       }
-      prop->mStringArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mStringArrayProperty);
       break;
     }
     case propertyTP_wstring_array: {
@@ -647,7 +839,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OWstringArrayProperty::sample_type(&values.front(),
                                                          values.size());
-      prop->mWstringArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mWstringArrayProperty);
     }
     case propertyTP_v2s_array: {
       _COPY_TUPLE_TO_VECTOR_AND_CONVERT_(Imath::V2s, short, int, "i", 2);
@@ -655,7 +847,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV2sArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV2sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV2sArrayProperty);
       break;
     }
     case propertyTP_v2i_array: {
@@ -664,7 +856,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV2iArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV2iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV2iArrayProperty);
       break;
     }
     case propertyTP_v2f_array: {
@@ -673,7 +865,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV2fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV2fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV2fArrayProperty);
       break;
     }
     case propertyTP_v2d_array: {
@@ -682,7 +874,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV2dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV2dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV2dArrayProperty);
       break;
     }
     case propertyTP_v3s_array: {
@@ -691,7 +883,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV3sArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV3sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV3sArrayProperty);
       break;
     }
     case propertyTP_v3i_array: {
@@ -700,7 +892,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV3iArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV3iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV3iArrayProperty);
       break;
     }
     case propertyTP_v3f_array: {
@@ -709,7 +901,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV3fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV3fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV3fArrayProperty);
       break;
     }
     case propertyTP_v3d_array: {
@@ -718,7 +910,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OV3dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mV3dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mV3dArrayProperty);
       break;
     }
     case propertyTP_p2s_array: {
@@ -727,7 +919,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP2sArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP2sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP2sArrayProperty);
       break;
     }
     case propertyTP_p2i_array: {
@@ -736,7 +928,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP2iArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP2iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP2iArrayProperty);
       break;
     }
     case propertyTP_p2f_array: {
@@ -745,7 +937,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP2fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP2fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP2fArrayProperty);
       break;
     }
     case propertyTP_p2d_array: {
@@ -754,7 +946,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP2dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP2dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP2dArrayProperty);
       break;
     }
     case propertyTP_p3s_array: {
@@ -763,7 +955,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP3sArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP3sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP3sArrayProperty);
       break;
     }
     case propertyTP_p3i_array: {
@@ -772,7 +964,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP3iArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP3iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP3iArrayProperty);
       break;
     }
     case propertyTP_p3f_array: {
@@ -781,7 +973,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP3fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP3fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP3fArrayProperty);
       break;
     }
     case propertyTP_p3d_array: {
@@ -790,7 +982,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OP3dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mP3dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mP3dArrayProperty);
       break;
     }
     case propertyTP_box2s_array: {
@@ -799,7 +991,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox2sArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox2sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox2sArrayProperty);
       break;
     }
     case propertyTP_box2i_array: {
@@ -808,7 +1000,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox2iArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox2iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox2iArrayProperty);
       break;
     }
     case propertyTP_box2f_array: {
@@ -817,7 +1009,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox2fArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox2fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox2fArrayProperty);
       break;
     }
     case propertyTP_box2d_array: {
@@ -826,7 +1018,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox2dArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox2dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox2dArrayProperty);
       break;
     }
     case propertyTP_box3s_array: {
@@ -835,7 +1027,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox3sArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox3sArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox3sArrayProperty);
       break;
     }
     case propertyTP_box3i_array: {
@@ -844,7 +1036,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox3iArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox3iArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox3iArrayProperty);
       break;
     }
     case propertyTP_box3f_array: {
@@ -853,7 +1045,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox3fArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox3fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox3fArrayProperty);
       break;
     }
     case propertyTP_box3d_array: {
@@ -862,7 +1054,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OBox3dArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mBox3dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mBox3dArrayProperty);
       break;
     }
     case propertyTP_m33f_array: {
@@ -871,7 +1063,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OM33fArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mM33fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mM33fArrayProperty);
       break;
     }
     case propertyTP_m33d_array: {
@@ -880,7 +1072,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OM33dArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mM33dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mM33dArrayProperty);
       break;
     }
     case propertyTP_m44f_array: {
@@ -889,7 +1081,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OM44fArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mM44fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mM44fArrayProperty);
       break;
     }
     case propertyTP_m44d_array: {
@@ -898,7 +1090,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OM44dArrayProperty::sample_type(&values.front(),
                                                       values.size());
-      prop->mM44dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mM44dArrayProperty);
       break;
     }
     case propertyTP_quatf_array: {
@@ -907,7 +1099,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OQuatfArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mQuatfArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mQuatfArrayProperty);
       break;
     }
     case propertyTP_quatd_array: {
@@ -916,7 +1108,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample = Abc::OQuatdArrayProperty::sample_type(&values.front(),
                                                        values.size());
-      prop->mQuatdArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mQuatdArrayProperty);
       break;
     }
     case propertyTP_c3h_array: {
@@ -925,7 +1117,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC3hArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC3hArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC3hArrayProperty);
       break;
     }
     case propertyTP_c3f_array: {
@@ -934,7 +1126,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC3fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC3fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC3fArrayProperty);
       break;
     }
     case propertyTP_c3c_array: {
@@ -944,7 +1136,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC3cArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC3cArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC3cArrayProperty);
       break;
     }
     case propertyTP_c4h_array: {
@@ -953,7 +1145,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC4hArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC4hArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC4hArrayProperty);
       break;
     }
     case propertyTP_c4f_array: {
@@ -962,7 +1154,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC4fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC4fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC4fArrayProperty);
       break;
     }
     case propertyTP_c4c_array: {
@@ -972,7 +1164,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::OC4cArrayProperty::sample_type(&values.front(), values.size());
-      prop->mC4cArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mC4cArrayProperty);
       break;
     }
     case propertyTP_n2f_array: {
@@ -981,7 +1173,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::ON2fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mN2fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mN2fArrayProperty);
       break;
     }
     case propertyTP_n2d_array: {
@@ -990,7 +1182,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::ON2dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mN2dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mN2dArrayProperty);
       break;
     }
     case propertyTP_n3f_array: {
@@ -999,7 +1191,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::ON3fArrayProperty::sample_type(&values.front(), values.size());
-      prop->mN3fArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mN3fArrayProperty);
       break;
     }
     case propertyTP_n3d_array: {
@@ -1008,7 +1200,7 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
       if (values.size() > 0)
         sample =
             Abc::ON3dArrayProperty::sample_type(&values.front(), values.size());
-      prop->mN3dArrayProperty->set(sample);
+      _SET_ARRAY_SAMPLE_(mN3dArrayProperty);
       break;
     }
     default: {
@@ -1022,6 +1214,90 @@ static PyObject *oProperty_setValues(PyObject *self, PyObject *args)
   ALEMBIC_PYOBJECT_CATCH_STATEMENT
 }
 
+static PyObject *oProperty_setValuesRange(PyObject *self, PyObject *args)
+{
+  ALEMBIC_TRY_STATEMENT
+  oProperty *prop = (oProperty *)self;
+  if (prop->mArchive == NULL) {
+    PyErr_SetString(getError(), "Archive already closed!");
+    return NULL;
+  }
+  if (prop->mPropType == propertyTP_unknown) {
+    PyErr_SetString(getError(), "Unknown property type!");
+    return NULL;
+  }
+
+  PyObject *values = NULL;
+  PyObject *offsetsObj = NULL;
+  if (!PyArg_ParseTuple(args, "O|O", &values, &offsetsObj)) {
+    PyErr_SetString(getError(), "No sample buffer specified!");
+    return NULL;
+  }
+
+#if PY_VERSION_HEX >= 0x02060000
+  const long numSamples =
+      prop->mIsArray ? (long)prop->mBaseArrayProperty->getNumSamples()
+                     : (long)prop->mBaseScalarProperty->getNumSamples();
+
+  oProperty_bufferView buf;
+  size_t nbElements = 0;
+  if (!oProperty_getValuesBuffer(prop, values, buf, nbElements)) {
+    return NULL;
+  }
+
+  std::vector<size_t> offsets;
+  if (offsetsObj == NULL || offsetsObj == Py_None) {
+    if (prop->mIsArray) {
+      PyErr_SetString(getError(),
+                      "The sample offsets are required for array properties!");
+      return NULL;
+    }
+    // one element per sample
+    offsets.resize(nbElements + 1);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+      offsets[i] = i;
+    }
+  }
+  else if (!oProperty_getOffsets(offsetsObj, nbElements, offsets)) {
+    return NULL;
+  }
+
+  if (!prop->mIsArray) {
+    for (size_t i = 1; i < offsets.size(); ++i) {
+      if (offsets[i] - offsets[i - 1] != 1) {
+        PyErr_SetString(getError(),
+                        "Each sample of a single value property has to hold "
+                        "exactly one element!");
+        return NULL;
+      }
+    }
+  }
+
+  const AbcA::DataType &dataType = oProperty_getDataType(prop);
+  const size_t elementSize = dataType.getNumBytes();
+  const char *data = (const char *)buf.view.buf;
+  {
+    allowThreads threads(oProperty_allowThreads(prop));
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+      const char *sampleData = data + offsets[i] * elementSize;
+      if (prop->mIsArray) {
+        prop->mBaseArrayProperty->set(
+            AbcA::ArraySample(sampleData, dataType,
+                              AbcA::Dimensions(offsets[i + 1] - offsets[i])));
+      }
+      else {
+        prop->mBaseScalarProperty->set(sampleData);
+      }
+    }
+  }
+  return Py_BuildValue("l", numSamples);
+#else
+  PyErr_SetString(getError(), "setValuesRange requires Python 2.6 or later!");
+  return NULL;
+#endif
+  ALEMBIC_PYOBJECT_CATCH_STATEMENT
+}
+
 static PyObject *oProperty_isCompound(PyObject *self)
 {
   Py_INCREF(Py_False);
@@ -1035,7 +1311,17 @@ static PyMethodDef oProperty_methods[] = {
      "Appends a new sample to the property, given the values provided. The "
      "values have to be a flat list of components, matching the count of the "
      "property. For example if this is a vector3farray property the tuple has "
-     "to contain a multiple of 3 float values."},
+     "to contain a multiple of 3 float values. Since Python 2.6, any "
+     "contiguous buffer whose items match the type of the property (a numpy "
+     "array, a memoryview...) can be given instead, and is written without "
+     "any conversion."},
+    {"setValuesRange", (PyCFunction)oProperty_setValuesRange, METH_VARARGS,
+     "Appends several samples in one call, from a contiguous buffer holding "
+     "the values of all the samples one after the other (Python 2.6 and "
+     "later). The second argument gives the number of samples if they all "
+     "have the same size, or the nbSamples + 1 offsets of the first element "
+     "of each sample, as returned by iProperty.getValuesRange. It can be "
+     "omitted for single value properties."},
     {"isCompound", (PyCFunction)oProperty_isCompound, METH_NOARGS,
      "To distinguish between an oProperty and an oCompoundProperty, always "
      "returns false for oProperty."},
@@ -0,0 +1,40 @@
+import _ExocortexAlembicPython as alembic
+import os
+import sys
+import tempfile
+import unittest
+
+# ---- the archive, /a/b/c and /d below the top
+def write_archive(abc_file):
+   out_data = alembic.getOArchive(abc_file)
+   for identifier in ["/a", "/a/b", "/a/b/c", "/d"]:
+      out_data.createObject("AbcGeom_Xform_v1", identifier, 0)
+
+# ---- the identifiers yielded by iterObjects
+def iter_identifiers(abc_file, **filters):
+   in_data = alembic.getIArchive(abc_file)
+   return sorted([obj.getIdentifier() for obj in in_data.iterObjects(**filters)])
+
+class IterObjectsTest(unittest.TestCase):
+   def setUp(self):
+      handle, self.abc_file = tempfile.mkstemp(suffix=".abc")
+      os.close(handle)
+      write_archive(self.abc_file)
+
+   def tearDown(self):
+      os.remove(self.abc_file)
+
+   def test_no_max_depth(self):
+      self.assertEqual(iter_identifiers(self.abc_file), ["/a", "/a/b", "/a/b/c", "/d"])
+
+   def test_max_depth_0(self):
+      self.assertEqual(iter_identifiers(self.abc_file, maxDepth=0), [])
+
+   def test_max_depth_1(self):
+      self.assertEqual(iter_identifiers(self.abc_file, maxDepth=1), ["/a", "/d"])
+
+   def test_max_depth_and_glob(self):
+      self.assertEqual(iter_identifiers(self.abc_file, glob="/a*", maxDepth=2), ["/a", "/a/b"])
+
+if __name__ == "__main__":
+   unittest.main(argv=sys.argv)
@@ -36,6 +36,12 @@ class AbcObjectCache {
 
 typedef std::map<std::string, AbcObjectCache> AbcArchiveCache;
 
+// adds obj and its descendants to the cache, returns NULL if cancelled
+AbcObjectCache *addObjectToCache(AbcArchiveCache *fullNameToObjectCache,
+                                 Abc::IObject &obj,
+                                 std::string parentIdentifier,
+                                 CommonProgressBar *pBar);
+
 bool createAbcArchiveCache(Abc::IArchive *pArchive,
                            AbcArchiveCache *fullNameToObjectCache,
                            CommonProgressBar *pBar = 0);
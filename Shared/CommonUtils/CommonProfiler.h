@@ -115,10 +115,12 @@ struct empty_stats_policy {
 
 struct default_stats_policy {
   static stats_map stats;
+  static boost::mutex statsMutex;  // scopes can end in worker threads
 
   static void on_stop(std::string name, double sec, bool underflow,
                       bool overflow)
   {
+    boost::mutex::scoped_lock lock(statsMutex);
     // underflow and overflow are sticky.
     if (underflow) {
       stats[name] = counted_sum(-1, -1);
@@ -139,7 +141,12 @@ struct default_stats_policy {
     ESS_LOG_WARNING("profile name," << '\t' << "total elapsed," << '\t'
                                     << "entry count," << '\t' << "average");
 
-    for (stats_map::iterator i = stats.begin(); i != stats.end(); i++) {
+    stats_map snapshot;
+    {
+      boost::mutex::scoped_lock lock(statsMutex);
+      snapshot = stats;
+    }
+    for (stats_map::iterator i = snapshot.begin(); i != snapshot.end(); i++) {
       std::string sName = i->first;
       int nCount = i->second.first;
       double dTotal = i->second.second;
@@ -260,6 +267,7 @@ class logging_stats_policy {
   static void on_stop(std::string name, double sec, bool underflow,
                       bool overflow)
   {
+    boost::mutex::scoped_lock lock(default_stats_policy::statsMutex);
     // underflow and overflow are sticky.
     if (underflow) {
       default_stats_policy::stats[name] = counted_sum(-1, -1);
@@ -296,11 +304,18 @@ class logging_stats_policy {
 
     ESS_LOG_WARNING(strstream.str().c_str());
 
+    // the stats are taken and reset under the lock, the scopes of worker
+    // threads can still end
+    stats_map snapshot;
+    {
+      boost::mutex::scoped_lock lock(default_stats_policy::statsMutex);
+      snapshot.swap(default_stats_policy::stats);
+    }
+
     std::vector<sortableStatRecord> records;
-    records.reserve(default_stats_policy::stats.size());
+    records.reserve(snapshot.size());
 
-    for (stats_map::iterator i = default_stats_policy::stats.begin();
-         i != default_stats_policy::stats.end(); i++) {
+    for (stats_map::iterator i = snapshot.begin(); i != snapshot.end(); i++) {
       sortableStatRecord rec;
       rec.sName = i->first;
       rec.nCount = i->second.first;
@@ -329,7 +344,6 @@ class logging_stats_policy {
         "PROFILER REPORT "
         "<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<"
         "<<<<<<<<<<<<<<<<");
-    default_stats_policy::stats.clear();
   }
 };
 
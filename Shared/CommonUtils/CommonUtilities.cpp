@@ -6,6 +6,7 @@
 
 #ifdef ESS_PROFILING
 stats_map default_stats_policy::stats;
+boost::mutex default_stats_policy::statsMutex;
 #endif  // ESS_PROFILER
 
 #include "CommonPBar.h"
@@ -178,6 +179,14 @@ std::string addArchive(Alembic::Abc::IArchive* archive)
   return archive->getName().c_str();
 }
 
+std::string addArchive(Alembic::Abc::IArchive* archive,
+                       AbcArchiveCache& archiveCache)
+{
+  addArchive(archive);
+  gArchives.find(archive->getName())->second.archiveCache.swap(archiveCache);
+  return archive->getName().c_str();
+}
+
 void deleteArchive(std::string const& path)
 {
   ESS_PROFILE_SCOPE("deleteArchive");
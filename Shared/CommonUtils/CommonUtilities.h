@@ -56,7 +56,7 @@ class MRUCache {
   {
     for (int i = 0; i < entries.size(); i++) {
       if (entries[i].key == key) {
-        entries[i].lastAccess = nextAccess;
+        entries[i].lastAccess = nextAccess++;
         return entries[i].data;
       }
     }
@@ -103,6 +103,9 @@ AbcObjectCache* getObjectCacheFromArchive(std::string const& path,
 
 Alembic::Abc::IArchive* getArchiveFromID(std::string const& path);
 std::string addArchive(Alembic::Abc::IArchive* archive);
+// also takes the content of an already built archiveCache
+std::string addArchive(Alembic::Abc::IArchive* archive,
+                       AbcArchiveCache& archiveCache);
 void deleteArchive(std::string const& path);
 void deleteAllArchives();
 Alembic::Abc::IObject getObjectFromArchive(std::string const& path,